@@ -0,0 +1,149 @@
+#ifndef S21_ALLOCATOR_H_
+#define S21_ALLOCATOR_H_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace s21 {
+// Pool state behind node_pool_allocator. Each block size and alignment gets
+// a size class of its own: blocks are carved from slabs that double in size
+// up to kMaxSlabBlocks, and freed blocks go on the freelist of their class
+// for the next allocation. Slabs are released only when the pool dies. A
+// container allocates its nodes and little else, so a pool rarely holds
+// more than a class or two and finds one by a linear scan.
+class NodePool {
+ public:
+  NodePool() = default;
+  NodePool(const NodePool &other) = delete;
+  NodePool &operator=(const NodePool &other) = delete;
+  ~NodePool() {
+    for (SizeClass_ &cls : classes_)
+      for (void *slab : cls.slabs_)
+        ::operator delete(slab, std::align_val_t(cls.align_));
+  }
+
+  void *Allocate(std::size_t size, std::size_t align) {
+    SizeClass_ &cls = ClassFor_(size, align);
+    if (cls.free_) {
+      FreeBlock_ *block = cls.free_;
+      cls.free_ = block->next_;
+      return block;
+    }
+    if (cls.used_ == cls.slab_blocks_) NewSlab_(cls);
+    return static_cast<unsigned char *>(cls.slabs_.back()) +
+           cls.size_ * cls.used_++;
+  }
+  void Deallocate(void *ptr, std::size_t size, std::size_t align) noexcept {
+    SizeClass_ &cls = ClassFor_(size, align);
+    FreeBlock_ *block = static_cast<FreeBlock_ *>(ptr);
+    block->next_ = cls.free_;
+    cls.free_ = block;
+  }
+
+ private:
+  static constexpr std::size_t kMinSlabBlocks = 32;
+  static constexpr std::size_t kMaxSlabBlocks = 4096;
+
+  struct FreeBlock_ {
+    FreeBlock_ *next_;
+  };
+
+  // size_ is a multiple of align_, so every block of a slab stays aligned.
+  struct SizeClass_ {
+    SizeClass_(std::size_t size, std::size_t align)
+        : size_(size), align_(align) {}
+    std::size_t size_;
+    std::size_t align_;
+    FreeBlock_ *free_ = nullptr;
+    std::size_t slab_blocks_ = 0;
+    std::size_t used_ = 0;
+    std::vector<void *> slabs_;
+  };
+
+  std::vector<SizeClass_> classes_;
+
+  SizeClass_ &ClassFor_(std::size_t size, std::size_t align) {
+    if (align < alignof(FreeBlock_)) align = alignof(FreeBlock_);
+    if (size < sizeof(FreeBlock_)) size = sizeof(FreeBlock_);
+    size = (size + align - 1) / align * align;
+    for (SizeClass_ &cls : classes_)
+      if (cls.size_ == size && cls.align_ == align) return cls;
+    classes_.emplace_back(size, align);
+    return classes_.back();
+  }
+  static void NewSlab_(SizeClass_ &cls) {
+    std::size_t blocks =
+        cls.slab_blocks_ ? cls.slab_blocks_ * 2 : kMinSlabBlocks;
+    if (blocks > kMaxSlabBlocks) blocks = kMaxSlabBlocks;
+    cls.slabs_.reserve(cls.slabs_.size() + 1);
+    cls.slabs_.push_back(
+        ::operator new(blocks * cls.size_, std::align_val_t(cls.align_)));
+    cls.slab_blocks_ = blocks;
+    cls.used_ = 0;
+  }
+};
+
+// Pool allocator for node-based containers. Single objects come from a
+// NodePool and array requests fall through to std::allocator.
+//
+// A default-constructed allocator starts a new pool. Copies and rebinds of
+// an allocator share its pool and compare equal to it, so a tree's node
+// allocator, the allocator it was given and the trees copied from it can
+// all free each other's nodes, and merge, join and node handles relink
+// nodes between them rather than copying elements. A pool is not
+// synchronised, so containers sharing one must not be modified from
+// different threads at once.
+template <typename T>
+class node_pool_allocator {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  node_pool_allocator() : pool_(std::make_shared<NodePool>()) {}
+  // Declared so that a move copies too: a moved-from allocator must still
+  // free what it allocated.
+  node_pool_allocator(const node_pool_allocator &other) noexcept = default;
+  template <typename U>
+  node_pool_allocator(const node_pool_allocator<U> &other) noexcept
+      : pool_(other.pool_) {}
+  node_pool_allocator &operator=(const node_pool_allocator &other) noexcept =
+      default;
+
+  T *allocate(size_type n) {
+    if (n != 1) return std::allocator<T>().allocate(n);
+    return static_cast<T *>(pool_->Allocate(sizeof(T), alignof(T)));
+  }
+  void deallocate(T *ptr, size_type n) noexcept {
+    if (n != 1)
+      std::allocator<T>().deallocate(ptr, n);
+    else
+      pool_->Deallocate(ptr, sizeof(T), alignof(T));
+  }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T);
+  }
+
+  template <typename U>
+  bool operator==(const node_pool_allocator<U> &other) const noexcept {
+    return pool_ == other.pool_;
+  }
+  template <typename U>
+  bool operator!=(const node_pool_allocator<U> &other) const noexcept {
+    return pool_ != other.pool_;
+  }
+
+ private:
+  template <typename U>
+  friend class node_pool_allocator;
+
+  std::shared_ptr<NodePool> pool_;
+};
+}  // namespace s21
+
+#endif  // S21_ALLOCATOR_H_
@@ -1,70 +1,210 @@
+#ifndef S21_BINARY_TREE_H_
+#define S21_BINARY_TREE_H_
+
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace s21 {
+// Mapped type of key-only trees: set and multiset instantiate Tree with it so
+// that a node stores the bare key instead of a std::pair<const K, K>.
+struct KeyOnly {};
+
 template <typename K, typename V>
+struct TreeValue {
+  using type = std::pair<const K, V>;
+  static const K &Key(const type &value) noexcept { return value.first; }
+};
+
+template <typename K>
+struct TreeValue<K, KeyOnly> {
+  using type = K;
+  static const K &Key(const type &value) noexcept { return value; }
+};
+
+// A transparent comparator orders lookup keys of other types against K
+// directly; any other comparator sees lookup keys converted to K first.
+template <typename C, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename C>
+struct IsTransparent<C, std::void_t<typename C::is_transparent>>
+    : std::true_type {};
+
+// A comparator may also offer compare(a, b), negative, zero or positive as a
+// is ordered before, with or after b. Tree then settles each level of a
+// search with that one call instead of two calls to operator().
+template <typename C, typename L, typename R, typename = void>
+struct HasThreeWay : std::false_type {};
+
+template <typename C, typename L, typename R>
+struct HasThreeWay<C, L, R,
+                   std::void_t<decltype(std::declval<const C &>().compare(
+                       std::declval<const L &>(), std::declval<const R &>()))>>
+    : std::true_type {};
+
+template <typename L, typename R, typename = void>
+struct HasCompareMember : std::false_type {};
+
+template <typename L, typename R>
+struct HasCompareMember<L, R,
+                        std::void_t<decltype(std::declval<const L &>().compare(
+                            std::declval<const R &>()))>> : std::true_type {};
+
+// Transparent less-than with a three-way compare(). Strings and string views
+// go through their own compare(), which scans a common prefix once where two
+// operator< calls would scan it twice; other types fall back to operator<.
+struct three_way_less {
+  using is_transparent = void;
+
+  template <typename L, typename R>
+  bool operator()(const L &a, const R &b) const {
+    return a < b;
+  }
+  template <typename L, typename R>
+  int compare(const L &a, const R &b) const {
+    if constexpr (HasCompareMember<L, R>::value) {
+      int res = a.compare(b);
+      return (res > 0) - (res < 0);
+    } else if constexpr (HasCompareMember<R, L>::value) {
+      int res = b.compare(a);
+      return (res < 0) - (res > 0);
+    } else {
+      return a < b ? -1 : (b < a ? 1 : 0);
+    }
+  }
+};
+
+// R turns on order statistics: every node also keeps the size of its
+// subtree, which makes nth, rank, count and iterator jumps O(log n) and lets
+// split and range extraction size their results without walking them.
+// Keeping the sizes costs a walk up to the root on every insert and erase,
+// even where the rebalancing stops early; with R off the same operations
+// walk the elements in order instead.
+//
+// map, set and multiset pass R on as their Ranked parameter. It is on for
+// all three by default, since split and extract_range promise O(log n) and
+// the parallel algorithms even ranges only with the counts; Ranked = false
+// is for trees that need none of these.
+template <typename K, typename V, typename C = std::less<>,
+          typename A = std::allocator<typename TreeValue<K, V>::type>,
+          bool R = true>
 class Tree {
  public:
   using key_type = K;
   using mapped_type = V;
-  using value_type = std::pair<const key_type, mapped_type>;
+  using value_type = typename TreeValue<K, V>::type;
+  using key_compare = C;
+  using allocator_type = A;
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
 
   // CONSTRUCTORS
-  Tree() noexcept;
+  Tree() noexcept(std::is_nothrow_default_constructible<A>::value &&
+                  std::is_nothrow_default_constructible<C>::value);
+  explicit Tree(const A &alloc);
+  explicit Tree(const C &comp, const A &alloc = A());
 
-  explicit Tree(const value_type &elem) noexcept;
+  explicit Tree(const value_type &elem);
   Tree(std::initializer_list<value_type> const &items);
-  Tree(const Tree &other) noexcept;
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  Tree(InputIt first, InputIt last);
+  Tree(const Tree &other);
   Tree(Tree &&other) noexcept;
 
   // DESTRUCTOR
   virtual ~Tree();
 
   // BASIC METHODS
+  allocator_type get_allocator() const;
+  key_compare key_comp() const { return comp_; }
   bool empty() const noexcept;
   size_type size() const noexcept;
+  // Inserting, merging or joining past max_size() throws std::length_error
+  // and leaves the tree as it was. With R that is 2^32 - 1 elements at most.
   size_type max_size() const noexcept;
   void clear() noexcept;
-  void merge(Tree<K, V> &other);
+  void merge(Tree<K, V, C, A, R> &other);
   void swap(Tree &other);
-  bool contains(const K &key) const noexcept;
+  template <typename T = K>
+  bool contains(const T &key) const;
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last);
 
   // OVERLOAD OPERATORS
-  Tree &operator=(const Tree &other) noexcept;
+  Tree &operator=(const Tree &other);
   Tree &operator=(Tree &&other) noexcept;
 
  protected:
-  typedef struct Node_ {
+  // One allocation per element: the node carries the element, its AVL height
+  // and all three links, so rebalancing only relinks pointers. count_ is the
+  // number of elements in the subtree, kept up to date only when R is set.
+  // It sits in the padding after height_, so it costs no memory either way,
+  // but it caps a tree with R at 2^32 - 1 elements.
+  struct Node_ {
     value_type element_;
+    Node_ *parent_;
+    Node_ *left_;
+    Node_ *right_;
     unsigned char height_;
-    explicit Node_(const value_type &elem) : element_(elem), height_(1) {};
-  } Node_;
+    std::uint32_t count_;
+    template <typename... Args>
+    explicit Node_(Node_ *parent, Args &&...args)
+        : element_(std::forward<Args>(args)...),
+          parent_(parent),
+          left_(nullptr),
+          right_(nullptr),
+          height_(1),
+          count_(1) {}
+  };
+
+  // Nodes come from A rebound to Node_, so a pool allocator hands out
+  // whole nodes rather than elements.
+  using NodeAllocator_ =
+      typename std::allocator_traits<A>::template rebind_alloc<Node_>;
+  using NodeTraits_ = std::allocator_traits<NodeAllocator_>;
 
   Node_ *root_;
-  Tree *parent_;
-  Tree *left_;
-  Tree *right_;
+  size_type size_;
+  NodeAllocator_ alloc_;
+  C comp_;
 
+  // An iterator is a node and the tree it belongs to. end() has no node;
+  // the tree lets --end() find the largest element from the root. ++ and --
+  // follow parent links, so a full scan touches each edge twice and a step
+  // is amortised O(1). Stepping past either end stays at end().
   class ConstIterator {
    public:
-    ConstIterator() noexcept : tree_(nullptr) {}
-    ConstIterator(const ConstIterator &other) { tree_ = other.tree_; }
-    explicit ConstIterator(Tree<K, V> *tree) noexcept : tree_(tree) {}
-    ~ConstIterator() = default;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Tree::value_type;
+    using difference_type = Tree::difference_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
 
-    bool operator==(const ConstIterator &other) {
-      return this->tree_ == other.tree_;
+    ConstIterator() noexcept : node_(nullptr), tree_(nullptr) {}
+    ConstIterator(Node_ *node, const Tree *tree) noexcept
+        : node_(node), tree_(tree) {}
+
+    bool operator==(const ConstIterator &other) const {
+      return node_ == other.node_;
     }
-    bool operator!=(const ConstIterator &other) {
-      return this->tree_ != other.tree_;
+    bool operator!=(const ConstIterator &other) const {
+      return node_ != other.node_;
     }
-    const value_type *operator->() { return &(tree_->root_->element_); }
-    ConstIterator operator++() {
+    const_reference operator*() const { return node_->element_; }
+    const value_type *operator->() const { return &node_->element_; }
+    ConstIterator &operator++() {
       OperationPlus_();
       return *this;
     }
@@ -73,11 +213,11 @@ class Tree {
       OperationPlus_();
       return tmp;
     }
-    ConstIterator operator+=(size_type n) {
-      while (n-- > 0) operator++();
+    ConstIterator &operator+=(size_type n) {
+      if (node_) node_ = Tree::Advance_(node_, n);
       return *this;
     }
-    ConstIterator operator--() {
+    ConstIterator &operator--() {
       OperationMinus_();
       return *this;
     }
@@ -86,511 +226,1452 @@ class Tree {
       OperationMinus_();
       return tmp;
     }
-    ConstIterator operator-=(size_type n) {
-      while (n-- > 0) operator--();
+    ConstIterator &operator-=(size_type n) {
+      if (!node_ && n) {
+        OperationMinus_();
+        --n;
+      }
+      if (node_)
+        node_ = Tree::Advance_(node_, -static_cast<difference_type>(n));
       return *this;
     }
-    Tree<K, V> *GetTree() { return tree_; }
-    Node_ *GetNode() { return tree_->root_; }
-    void SetTree(Tree<K, V> *tr) noexcept { tree_ = tr; }
+    Node_ *GetNode() const noexcept { return node_; }
 
    protected:
-    Tree<K, V> *tree_;
+    Node_ *node_;
+    const Tree *tree_;
     void OperationPlus_() {
-      if (tree_->right_)
-        tree_ = tree_->FindMin(tree_->right_);
-      else if (!tree_->left_ && !tree_->right_) {
-        if (tree_->parent_) {
-          if (tree_->parent_->left_ == tree_)
-            tree_ = tree_->parent_;
-          else if (tree_->parent_->right_ == tree_)
-            if (tree_->parent_ && tree_->parent_->parent_)
-              tree_ = tree_->parent_->parent_;
-        }
-      } else if (tree_->parent_) {
-        tree_ = tree_->parent_;
-      }
+      if (node_) node_ = Tree::Next_(node_);
     }
     void OperationMinus_() {
-      if (tree_->left_)
-        tree_ = tree_->FindMax(tree_->left_);
-      else if (!tree_->left_ && !tree_->right_) {
-        if (tree_->parent_) {
-          if (tree_->parent_->right_ == tree_)
-            tree_ = tree_->parent_;
-          else if (tree_->parent_->left_ == tree_)
-            if (tree_->parent_ && tree_->parent_->parent_)
-              tree_ = tree_->parent_->parent_;
-        }
-      } else if (tree_->parent_) {
-        tree_ = tree_->parent_;
+      if (!node_) {
+        if (tree_ && tree_->root_) node_ = Tree::FindMax(tree_->root_);
+        return;
       }
+      Node_ *prev = Tree::Prev_(node_);
+      if (prev) node_ = prev;
     }
   };
 
   class Iterator : public ConstIterator {
    public:
+    using pointer = value_type *;
+    using reference = value_type &;
+
     Iterator() noexcept : ConstIterator() {}
-    explicit Iterator(Tree<K, V> *tree) noexcept : ConstIterator(tree) {}
-    ~Iterator() = default;
+    Iterator(Node_ *node, const Tree *tree) noexcept
+        : ConstIterator(node, tree) {}
 
-    value_type *operator->() { return &(this->tree_->root_->element_); }
+    reference operator*() const { return this->node_->element_; }
+    value_type *operator->() const { return &this->node_->element_; }
+    Iterator &operator++() {
+      this->OperationPlus_();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator tmp(*this);
+      this->OperationPlus_();
+      return tmp;
+    }
+    Iterator &operator--() {
+      this->OperationMinus_();
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator tmp(*this);
+      this->OperationMinus_();
+      return tmp;
+    }
   };
 
-  void Insert_(const value_type &elem, Iterator &iter,
-               bool &is_inserted) noexcept;
-
-  Tree *FindMin(const Tree *node) const;
-  Tree *FindMax(const Tree *node) const;
+  static const K &Key_(const Node_ *node) noexcept {
+    return TreeValue<K, V>::Key(node->element_);
+  }
 
-  void MultiSetInsert_(const value_type &elem, Iterator &iter,
-                       bool &is_inserted) noexcept {
-    if (!root_) {
-      root_ = new Node_(elem);
-      iter.SetTree(this);
-      is_inserted = true;
-      return;
-    }
-    if (elem.first <= root_->element_.first) {
-      if (!left_) {
-        left_ = new Tree;
-        left_->parent_ = this;
-      }
-      left_->MultiSetInsert_(elem, iter, is_inserted);
-    } else if (elem.first >= root_->element_.first) {
-      if (!right_) {
-        right_ = new Tree<K, K>;
-        right_->parent_ = this;
-      }
-      right_->MultiSetInsert_(elem, iter, is_inserted);
+  // Orders a against b through comp_: one call when C has compare(),
+  // otherwise up to two.
+  template <typename L, typename T>
+  int Compare_(const L &a, const T &b) const {
+    if constexpr (HasThreeWay<C, L, T>::value) {
+      return comp_.compare(a, b);
+    } else {
+      return comp_(a, b) ? -1 : (comp_(b, a) ? 1 : 0);
     }
-    Balance_();
   }
 
+  // The type a lookup key reaches comp_ as: itself when C is transparent,
+  // otherwise K, built once per lookup.
+  template <typename T>
+  using LookupKey_ = std::conditional_t<IsTransparent<C>::value, T, K>;
+
+  void Insert_(const value_type &elem, Iterator &iter, bool &is_inserted);
+  void MultiSetInsert_(const value_type &elem, Iterator &iter,
+                       bool &is_inserted);
+  template <typename... Args>
+  std::pair<Iterator, bool> Emplace_(bool unique, Args &&...args);
+  template <typename KeyArg, typename... Args>
+  std::pair<Iterator, bool> TryEmplace_(KeyArg &&key, Args &&...args);
+  template <typename Value>
+  Iterator HintInsert_(ConstIterator hint, Value &&elem, bool unique);
+  template <typename InputIt>
+  void AppendSorted_(InputIt first, InputIt last, bool unique);
+  template <typename InputIt>
+  void Assign_(InputIt first, InputIt last, bool unique);
+  void Merge_(Tree &other, bool unique);
+  void Join_(Tree &other, bool unique);
+  template <typename T>
+  Node_ *Find_(const T &key) const;
+  template <typename T>
+  Node_ *LowerBound_(const T &key) const;
+  template <typename T>
+  Node_ *UpperBound_(const T &key) const;
+  template <typename T>
+  size_type Rank_(const T &key, bool inclusive) const;
+  // Moves the elements from first up to last, null standing for end(),
+  // into out, replacing its contents.
+  void ExtractRange_(Node_ *first, Node_ *last, Tree &out);
+  template <typename T>
+  void ExtractKeys_(const T &lo, const T &hi, Tree &out);
+
+  static Node_ *FindMin(Node_ *node);
+  static Node_ *FindMax(Node_ *node);
+  static Node_ *Next_(Node_ *node);
+  static Node_ *Prev_(Node_ *node);
+  static Node_ *Select_(Node_ *node, size_type index);
+  static Node_ *Advance_(Node_ *node, difference_type offset);
+  static size_type Count_(const Node_ *node) noexcept;
+
  private:
-  unsigned char Height_(Tree *tr);
-  int BalanceFactor_();
-  void FixHeight_();
-  void RotateLeft_();
-  void RotateRight_();
-  void ChangePointers_(Tree *tmp, bool is_left);
-  void Balance_();
-  void Size_(int &size) const noexcept;
-  void Swap_(Tree<K, V> &other);
-  void Contains_(const K &key, bool &contains) const noexcept;
-  void RemoveThis_(Tree<K, V> *current);
-  void RemoveEdge_(Tree<K, V> *current, Tree<K, V> *parent);
-  void RemoveNode_(Tree<K, V> *current, Tree<K, V> *parent);
+  static unsigned char Height_(const Node_ *node);
+  static int BalanceFactor_(const Node_ *node);
+  static void FixNode_(Node_ *node);
+  void ReplaceChild_(Node_ *parent, Node_ *old_child, Node_ *new_child);
+  Node_ *RotateLeft_(Node_ *node);
+  Node_ *RotateRight_(Node_ *node);
+  Node_ *Balance_(Node_ *node);
+  void Retrace_(Node_ *node, bool grown);
+  Node_ *FindSlot_(const K &key, bool unique, Node_ *&parent,
+                   bool &left) const;
+  template <typename Value>
+  void InsertInto_(Value &&elem, Iterator &iter, bool &is_inserted,
+                   bool unique);
+  bool Fits_(const Node_ *prev, const Node_ *next, const K &key,
+             bool unique) const;
+  template <typename Value>
+  Node_ *LinkBetween_(Node_ *prev, Node_ *next, Value &&elem, bool unique);
+  void Attach_(Node_ *node, bool left);
+  template <typename... Args>
+  Node_ *CreateNode_(Node_ *parent, Args &&...args);
+  void Grow_(size_type more) const;
+  void DestroyNode_(Node_ *node) noexcept;
+  std::vector<Node_ *> Adopt_(const std::vector<Node_ *> &nodes);
+  void Swap_(Tree<K, V, C, A, R> &other);
+  void Transplant_(Node_ *node, Node_ *child);
+  void Unlink_(Node_ *node);
+  Node_ *JoinNodes_(Node_ *left, Node_ *mid, Node_ *right);
+  template <typename F>
+  void SplitBy_(Tree &greater, F goes_less);
+  void SizeHalves_(Tree &greater);
+  void Destroy_(Node_ *node);
+  Node_ *Clone_(const Node_ *node, Node_ *parent);
+  static Node_ *Build_(const std::vector<Node_ *> &nodes, size_type first,
+                       size_type last, Node_ *parent);
+  std::vector<Node_ *> Flatten_() const;
+  void Rebuild_(const std::vector<Node_ *> &nodes);
 
  public:
   using const_iterator = ConstIterator;
   using iterator = Iterator;
 
-  iterator begin() const {
-    if (!left_ && !right_ && !root_)
-      throw std::out_of_range("Tree does not exist");
-    const Tree<K, V> *tmp_this = this;
-    Tree<K, V> *min_tr = FindMin(left_ ? left_ : tmp_this);
-    return Iterator(min_tr);
-  }
-  iterator end() const {
-    if (!left_ && !right_ && !root_)
-      throw std::out_of_range("Tree does not exist");
-    const Tree<K, V> *tmp_this = this;
-    Tree<K, V> *max_tr = FindMax(right_ ? right_ : tmp_this);
-    return Iterator(max_tr);
+  iterator begin() const noexcept {
+    return Iterator(root_ ? FindMin(root_) : nullptr, this);
   }
+  iterator end() const noexcept { return Iterator(nullptr, this); }
 
   void erase(iterator pos);
-  virtual std::pair<iterator, bool> insert(const value_type &value) noexcept;
-
-  Tree<K, V> *GetTree_(iterator pos) { return pos.GetTree(); }
-  Node_ *GetNode_(iterator pos) { return pos.GetNode(); }
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  // emplace builds the element in its node from args, before the search
+  // that needs its key; when a map or set already holds that key the node
+  // is freed again. insert_many inserts each argument in turn, converting
+  // it to value_type first when it is not one.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
 
+  // HINTED INSERTION
+  // hint is the position the element is expected to go right before. When
+  // the key belongs there the element is linked in after at most two key
+  // comparisons instead of a descent from the root; a wrong hint costs those
+  // comparisons on top of the usual insertion. A map or set returns the
+  // element already holding the key, if any. append_sorted inserts a range
+  // ordered by the comparator, each element hinting at the next, so a range
+  // that continues past the largest key never descends. Elements out of order
+  // are still inserted, through the usual descent.
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
   template <typename... Args>
-  std::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
-    std::vector<std::pair<iterator, bool>> res_vec;
-    for (auto elem : {std::forward<Args>(args)...}) {
-      res_vec.push_back(insert(elem));
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+  template <typename InputIt>
+  void append_sorted(InputIt first, InputIt last);
+
+  // LOOKUP
+  // find returns end() for a missing key, and the bounds return end() when
+  // no element qualifies.
+  //
+  // With a transparent comparator, the default std::less<> included, lookups
+  // take anything comparable with K both ways (a std::string_view or
+  // const char * for std::string keys) and never build a temporary key. Any
+  // other comparator gets the argument converted to K once. A braced
+  // argument always converts to K.
+  template <typename T = K>
+  iterator find(const T &key) const;
+  template <typename T = K>
+  iterator lower_bound(const T &key) const;
+  template <typename T = K>
+  iterator upper_bound(const T &key) const;
+  template <typename T = K>
+  std::pair<iterator, iterator> equal_range(const T &key) const;
+
+  // ORDER STATISTICS
+  // nth(k) is the k-th smallest element counting from zero and throws
+  // std::out_of_range when k >= size(); rank(key) is the number of elements
+  // ordered before key. count(key) is the number of elements equal to key.
+  // With R all three are O(log n), count however many copies there are;
+  // without R, nth walks in from the nearer end, rank from the smallest
+  // element, and count over the copies.
+  //
+  // slices(count) cuts the tree into at most count ranges that follow each
+  // other in order and returns the first element of each, begin() first; a
+  // range runs up to the first element of the next one, the last up to
+  // end(). With R the ranges are equal in size to within one element.
+  // Without R they are whole subtrees, the tallest cut first; AVL siblings
+  // may differ in size by a factor that grows with their height, so the
+  // ranges are only roughly even.
+  iterator nth(size_type k) const;
+  template <typename T = K>
+  size_type rank(const T &key) const;
+  template <typename T = K>
+  size_type count(const T &key) const;
+  std::vector<iterator> slices(size_type count) const;
+
+  // SET ALGEBRA
+  // Both trees are walked in order once and the result is rebuilt balanced,
+  // so each operation is O(n + m). Nodes of *this are reused; unite copies
+  // the elements it takes from other, merge moves them. Keys are compared
+  // alone, so a map keeps its own value for a key found in both. Equal keys
+  // of a multiset pair up one to one: unite keeps the larger multiplicity,
+  // intersect the smaller, subtract the difference.
+  void unite(const Tree &other);
+  void intersect(const Tree &other);
+  void subtract(const Tree &other);
+
+  // SPLIT AND JOIN
+  // split leaves the keys ordered before key in *this and moves the rest into
+  // greater, replacing its contents. join appends other, whose keys must all
+  // be ordered after those of *this, and throws std::invalid_argument when
+  // the ranges overlap. Both relink nodes in O(log n); without R, split
+  // then walks the smaller half to learn the sizes.
+  void split(const K &key, Tree &greater);
+  void join(Tree &other);
+
+  // RANGE ERASURE
+  // erase(first, last) removes the elements from first up to last and
+  // returns last; erase_range(lo, hi) removes those with keys in [lo, hi)
+  // and returns how many there were. extract_range moves the elements with
+  // keys in [lo, hi) into a tree of their own. The range is cut out with two
+  // splits and a join in O(log n), then freed or handed over node by node
+  // with no rebalancing, so k elements cost O(k + log n) in all.
+  //
+  // erase_many removes the elements at positions, which must be distinct
+  // and in order, and returns how many there were. A few are unlinked one by
+  // one; once that would cost more than a pass over the tree, the survivors
+  // are rebuilt into a balanced tree instead, in O(n) with no rebalancing.
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase_many(const std::vector<const_iterator> &positions);
+  template <typename T = K>
+  size_type erase_range(const T &lo, const T &hi);
+  template <typename T = K>
+  Tree extract_range(const T &lo, const T &hi);
+
+  // NODE HANDLES
+  // extract unlinks an element and returns its node in a node_type, which
+  // owns it until it goes into a tree of the same type or is destroyed. The
+  // element is neither copied nor moved, and its key may be changed while
+  // the node is out of any tree. extract(key) takes the first element equal
+  // to key and returns an empty handle when there is none.
+  //
+  // insert(node_type&&) links the node back in without allocating. A map or
+  // set that already holds the key leaves the node in the returned handle.
+  // A node made by an allocator unequal to the tree's cannot be relinked;
+  // its element is moved into a new node instead, as merge does.
+  class NodeHandle {
+   public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = Tree::value_type;
+    using allocator_type = A;
+
+    NodeHandle() noexcept : node_(nullptr) {}
+    NodeHandle(NodeHandle &&other) noexcept
+        : node_(other.node_), alloc_(std::move(other.alloc_)) {
+      other.node_ = nullptr;
     }
-    return res_vec;
-  }
+    NodeHandle &operator=(NodeHandle &&other) noexcept {
+      if (this != &other) {
+        Reset_();
+        node_ = other.node_;
+        alloc_ = std::move(other.alloc_);
+        other.node_ = nullptr;
+      }
+      return *this;
+    }
+    ~NodeHandle() { Reset_(); }
+
+    bool empty() const noexcept { return !node_; }
+    explicit operator bool() const noexcept { return node_; }
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+    value_type &value() const { return node_->element_; }
+    // The key is const inside a tree only so that iterators cannot reorder
+    // it; an extracted node belongs to no tree.
+    K &key() const {
+      return const_cast<K &>(TreeValue<K, V>::Key(node_->element_));
+    }
+    template <typename T = V>
+    std::enable_if_t<!std::is_same<T, KeyOnly>::value, T &> mapped() const {
+      return node_->element_.second;
+    }
+    void swap(NodeHandle &other) noexcept {
+      std::swap(node_, other.node_);
+      std::swap(alloc_, other.alloc_);
+    }
+
+   private:
+    friend class Tree;
+    NodeHandle(Node_ *node, const NodeAllocator_ &alloc)
+        : node_(node), alloc_(alloc) {}
+    void Reset_() noexcept {
+      if (!node_) return;
+      NodeTraits_::destroy(alloc_, node_);
+      NodeTraits_::deallocate(alloc_, node_, 1);
+      node_ = nullptr;
+    }
+
+    Node_ *node_;
+    NodeAllocator_ alloc_;
+  };
+
+  template <typename It>
+  struct InsertReturn {
+    It position;
+    bool inserted;
+    NodeHandle node;
+  };
+
+  using node_type = NodeHandle;
+  using insert_return_type = InsertReturn<iterator>;
+
+  node_type extract(const_iterator pos);
+  node_type extract(const K &key);
+  insert_return_type insert(node_type &&node);
+  iterator insert(const_iterator hint, node_type &&node);
+
+  Node_ *GetNode_(iterator pos) { return pos.GetNode(); }
+
+ protected:
+  // Leave nh untouched when the key is refused.
+  std::pair<Iterator, bool> InsertNode_(NodeHandle &nh, bool unique);
+  Iterator HintInsertNode_(ConstIterator hint, NodeHandle &nh, bool unique);
+
+ private:
+  Node_ *LinkHandle_(NodeHandle &nh, Node_ *parent, bool left);
 };
 
-template <typename K, typename V>
-Tree<K, V>::Tree() noexcept
-    : root_(nullptr), parent_(nullptr), left_(nullptr), right_(nullptr) {}
+template <typename K, typename V, typename C, typename A, bool R>
+Tree<K, V, C, A, R>::Tree() noexcept(
+    std::is_nothrow_default_constructible<A>::value &&
+    std::is_nothrow_default_constructible<C>::value)
+    : root_(nullptr), size_(0), alloc_(), comp_() {}
 
-template <typename K, typename V>
-Tree<K, V>::Tree(const value_type &elem) noexcept
-    : parent_(nullptr), left_(nullptr), right_(nullptr) {
-  root_ = new Node_(elem);
+template <typename K, typename V, typename C, typename A, bool R>
+Tree<K, V, C, A, R>::Tree(const A &alloc)
+    : root_(nullptr), size_(0), alloc_(alloc), comp_() {}
+
+template <typename K, typename V, typename C, typename A, bool R>
+Tree<K, V, C, A, R>::Tree(const C &comp, const A &alloc)
+    : root_(nullptr), size_(0), alloc_(alloc), comp_(comp) {}
+
+template <typename K, typename V, typename C, typename A, bool R>
+Tree<K, V, C, A, R>::Tree(const value_type &elem)
+    : root_(nullptr), size_(0), alloc_(), comp_() {
+  root_ = CreateNode_(nullptr, elem);
 }
 
-template <typename K, typename V>
-Tree<K, V>::~Tree() {
+template <typename K, typename V, typename C, typename A, bool R>
+Tree<K, V, C, A, R>::~Tree() {
   clear();
 }
 
-template <typename K, typename V>
-Tree<K, V> &Tree<K, V>::operator=(Tree &&other) noexcept {
+template <typename K, typename V, typename C, typename A, bool R>
+Tree<K, V, C, A, R> &Tree<K, V, C, A, R>::operator=(Tree &&other) noexcept {
   if (this != &other) {
-    parent_ = other.parent_;
-    right_ = other.right_;
-    left_ = other.left_;
-    root_ = other.root_;
-    other.parent_ = nullptr;
-    other.right_ = nullptr;
-    other.left_ = nullptr;
-    other.root_ = nullptr;
+    clear();
+    Swap_(other);
   }
   return *this;
 }
 
-template <typename K, typename V>
-typename Tree<K, V>::size_type Tree<K, V>::size() const noexcept {
-  int size = 0;
-  Size_(size);
-  return size;
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::size_type Tree<K, V, C, A, R>::size()
+    const noexcept {
+  return size_;
 }
 
-template <typename K, typename V>
-inline unsigned char Tree<K, V>::Height_(Tree *tr) {
-  return (tr ? tr->root_ ? tr->root_->height_ : 0 : 0);
+template <typename K, typename V, typename C, typename A, bool R>
+inline unsigned char Tree<K, V, C, A, R>::Height_(const Node_ *node) {
+  return node ? node->height_ : 0;
 }
 
-template <typename K, typename V>
-inline int Tree<K, V>::BalanceFactor_() {
-  return (Height_(right_) - Height_(left_));
+template <typename K, typename V, typename C, typename A, bool R>
+inline int Tree<K, V, C, A, R>::BalanceFactor_(const Node_ *node) {
+  return Height_(node->right_) - Height_(node->left_);
 }
 
-template <typename K, typename V>
-void Tree<K, V>::FixHeight_() {
-  root_->height_ =
-      (Height_(left_) > Height_(right_) ? Height_(left_) : Height_(right_)) + 1;
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::FixNode_(Node_ *node) {
+  unsigned char left = Height_(node->left_);
+  unsigned char right = Height_(node->right_);
+  node->height_ = (left > right ? left : right) + 1;
+  if constexpr (R)
+    node->count_ = Count_(node->left_) + Count_(node->right_) + 1;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::RotateLeft_() {
-  Tree *tmp_right = right_;
-  Tree *tmp_parent = parent_;
-  right_ = tmp_right->left_;
-  ChangePointers_(tmp_right, true);
-  FixHeight_();
-  tmp_right->FixHeight_();
-  *this = std::move(*tmp_right);
-  parent_ = tmp_parent;
-  left_->parent_ = this;
-  // NEW
-  if (right_) right_->parent_ = this;
-  // NEW
-  // CRINGE
-  if (left_) {
-    if (left_->right_) {
-      if (!left_->right_->parent_->root_)
-        left_->right_->parent_->root_ =
-            new Node_(left_->right_->root_->element_);
-      left_->right_->parent_ = left_;
-    }
-    if (left_->left_) {
-      if (!left_->left_->parent_->root_)
-        left_->left_->parent_->root_ = new Node_(left_->left_->root_->element_);
-      left_->left_->parent_ = left_;
-    }
-  }
-  // CRINGE
-  delete tmp_right;
-  tmp_right = nullptr;
+template <typename K, typename V, typename C, typename A, bool R>
+inline typename Tree<K, V, C, A, R>::size_type Tree<K, V, C, A, R>::Count_(
+    const Node_ *node) noexcept {
+  return node ? node->count_ : 0;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::RotateRight_() {
-  Tree *tmp_left = left_;
-  Tree *tmp_parent = parent_;
-  left_ = tmp_left->right_;
-  //        tmp_left->parent_ = parent_;
-  //        parent_ = tmp_left;
-  ChangePointers_(tmp_left, false);
-  FixHeight_();
-  tmp_left->FixHeight_();
-  *this = std::move(*tmp_left);
-  parent_ = tmp_parent;
-  right_->parent_ = this;
-  // NEW
-  if (left_) left_->parent_ = this;
-  // NEW
-  // CRINGE
-  if (right_) {
-    if (right_->left_) {
-      if (!right_->left_->parent_->root_)
-        right_->left_->parent_->root_ =
-            new Node_(right_->left_->root_->element_);
-      right_->left_->parent_ = right_;
-    }
-    if (right_->right_) {
-      if (!right_->right_->parent_->root_)
-        right_->right_->parent_->root_ =
-            new Node_(right_->right_->root_->element_);
-      right_->right_->parent_ = right_;
-    }
-  }
-  // CRINGE
-  delete tmp_left;
-  tmp_left = nullptr;
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::ReplaceChild_(Node_ *parent, Node_ *old_child,
+                                        Node_ *new_child) {
+  if (!parent)
+    root_ = new_child;
+  else if (parent->left_ == old_child)
+    parent->left_ = new_child;
+  else
+    parent->right_ = new_child;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::ChangePointers_(Tree *tmp, bool is_left) {
-  auto *tmp_this = new Tree<K, V>();
-  tmp_this->parent_ = parent_;
-  tmp_this->left_ = left_;
-  tmp_this->right_ = right_;
-  tmp_this->root_ = root_;
-  if (is_left)
-    tmp->left_ = tmp_this;
-  else
-    tmp->right_ = tmp_this;
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::RotateLeft_(
+    Node_ *node) {
+  Node_ *pivot = node->right_;
+  node->right_ = pivot->left_;
+  if (pivot->left_) pivot->left_->parent_ = node;
+  pivot->parent_ = node->parent_;
+  ReplaceChild_(node->parent_, node, pivot);
+  pivot->left_ = node;
+  node->parent_ = pivot;
+  FixNode_(node);
+  FixNode_(pivot);
+  return pivot;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::Balance_() {
-  FixHeight_();
-  int balance = BalanceFactor_();
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::RotateRight_(
+    Node_ *node) {
+  Node_ *pivot = node->left_;
+  node->left_ = pivot->right_;
+  if (pivot->right_) pivot->right_->parent_ = node;
+  pivot->parent_ = node->parent_;
+  ReplaceChild_(node->parent_, node, pivot);
+  pivot->right_ = node;
+  node->parent_ = pivot;
+  FixNode_(node);
+  FixNode_(pivot);
+  return pivot;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::Balance_(
+    Node_ *node) {
+  FixNode_(node);
+  int balance = BalanceFactor_(node);
   if (balance == 2) {
-    if (right_->BalanceFactor_() < 0) {
-      right_->RotateRight_();
-    }
-    RotateLeft_();
+    if (BalanceFactor_(node->right_) < 0) RotateRight_(node->right_);
+    return RotateLeft_(node);
   } else if (balance == -2) {
-    if (left_->BalanceFactor_() > 0) left_->RotateLeft_();
-    RotateRight_();
+    if (BalanceFactor_(node->left_) > 0) RotateLeft_(node->left_);
+    return RotateRight_(node);
   }
+  return node;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::Insert_(const value_type &elem, Iterator &iter,
-                         bool &is_inserted) noexcept {
-  if (!root_) {
-    root_ = new Node_(elem);
-    iter.SetTree(this);
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::Insert_(const value_type &elem, Iterator &iter,
+                                  bool &is_inserted) {
+  InsertInto_(elem, iter, is_inserted, true);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::MultiSetInsert_(const value_type &elem,
+                                          Iterator &iter, bool &is_inserted) {
+  InsertInto_(elem, iter, is_inserted, false);
+}
+
+// Finds the free slot key goes into: the left or right child of parent, or
+// the root when parent is null. A unique tree that already holds key returns
+// that node instead; otherwise the result is nullptr.
+//
+// One comparison decides each level of the descent. Without a three-way
+// comparator a unique tree looks for an equal key once, at the bottom: the
+// last node the descent passed on its right holds the greatest key not
+// ordered after the new one. Equal keys of a multiset go right, after the
+// ones already present.
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::FindSlot_(
+    const K &key, bool unique, Node_ *&parent, bool &left) const {
+  parent = nullptr;
+  left = false;
+  Node_ *candidate = nullptr;
+  for (Node_ *node = root_; node; node = left ? node->left_ : node->right_) {
+    parent = node;
+    if constexpr (HasThreeWay<C, K, K>::value) {
+      int res = Compare_(key, Key_(node));
+      if (unique && !res) return node;
+      left = res < 0;
+    } else {
+      left = comp_(key, Key_(node));
+      if (!left) candidate = node;
+    }
+  }
+  if (unique && candidate && !comp_(Key_(candidate), key)) return candidate;
+  return nullptr;
+}
+
+// The key is read before elem is moved into its node.
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename Value>
+void Tree<K, V, C, A, R>::InsertInto_(Value &&elem, Iterator &iter,
+                                      bool &is_inserted, bool unique) {
+  Node_ *parent;
+  bool left;
+  Node_ *node = FindSlot_(TreeValue<K, V>::Key(elem), unique, parent, left);
+  if (!node) {
+    node = CreateNode_(parent, std::forward<Value>(elem));
+    Attach_(node, left);
     is_inserted = true;
-    return;
   }
-  if (elem.first < root_->element_.first) {
-    if (!left_) {
-      left_ = new Tree;
-      left_->parent_ = this;
+  iter = Iterator(node, this);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename... Args>
+std::pair<typename Tree<K, V, C, A, R>::Iterator, bool>
+Tree<K, V, C, A, R>::Emplace_(bool unique, Args &&...args) {
+  Node_ *node = CreateNode_(nullptr, std::forward<Args>(args)...);
+  Node_ *parent;
+  bool left;
+  Node_ *found = FindSlot_(Key_(node), unique, parent, left);
+  if (found) {
+    DestroyNode_(node);
+    --size_;
+    return {Iterator(found, this), false};
+  }
+  node->parent_ = parent;
+  Attach_(node, left);
+  return {Iterator(node, this), true};
+}
+
+// Looks key up first and builds the pair only when the key is new, the
+// mapped value in place from args.
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename KeyArg, typename... Args>
+std::pair<typename Tree<K, V, C, A, R>::Iterator, bool>
+Tree<K, V, C, A, R>::TryEmplace_(KeyArg &&key, Args &&...args) {
+  Node_ *parent;
+  bool left;
+  Node_ *node = FindSlot_(key, true, parent, left);
+  if (node) return {Iterator(node, this), false};
+  node = CreateNode_(parent, std::piecewise_construct,
+                     std::forward_as_tuple(std::forward<KeyArg>(key)),
+                     std::forward_as_tuple(std::forward<Args>(args)...));
+  Attach_(node, left);
+  return {Iterator(node, this), true};
+}
+
+// Hangs a new leaf off its parent, or makes it the root of an empty tree,
+// and rebalances above it.
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::Attach_(Node_ *node, bool left) {
+  Node_ *parent = node->parent_;
+  if (!parent)
+    root_ = node;
+  else if (left)
+    parent->left_ = node;
+  else
+    parent->right_ = node;
+  Retrace_(parent, true);
+}
+
+// prev and next are neighbours in order, either null past an end of the
+// tree. If the key of elem belongs between them it becomes a leaf there:
+// the right child of prev when that slot is free, otherwise the left child
+// of next, which is then the leftmost node of prev's right subtree. Returns
+// nullptr when the key belongs elsewhere, or when a unique tree may already
+// hold it.
+template <typename K, typename V, typename C, typename A, bool R>
+bool Tree<K, V, C, A, R>::Fits_(const Node_ *prev, const Node_ *next,
+                                const K &key, bool unique) const {
+  if (unique)
+    return (!prev || comp_(Key_(prev), key)) &&
+           (!next || comp_(key, Key_(next)));
+  return (!prev || !comp_(key, Key_(prev))) &&
+         (!next || !comp_(Key_(next), key));
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename Value>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::LinkBetween_(
+    Node_ *prev, Node_ *next, Value &&elem, bool unique) {
+  if (!Fits_(prev, next, TreeValue<K, V>::Key(elem), unique)) return nullptr;
+  bool left = !prev || prev->right_;
+  Node_ *node = CreateNode_(left ? next : prev, std::forward<Value>(elem));
+  Attach_(node, left);
+  return node;
+}
+
+// LinkBetween_ leaves elem alone when it returns nullptr, so the descent can
+// still take it.
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename Value>
+typename Tree<K, V, C, A, R>::Iterator Tree<K, V, C, A, R>::HintInsert_(
+    ConstIterator hint, Value &&elem, bool unique) {
+  Node_ *next = hint.GetNode();
+  Node_ *prev = next ? Prev_(next) : (root_ ? FindMax(root_) : nullptr);
+  Iterator iter(LinkBetween_(prev, next, std::forward<Value>(elem), unique),
+                this);
+  if (!iter.GetNode()) {
+    bool is_inserted = false;
+    InsertInto_(std::forward<Value>(elem), iter, is_inserted, unique);
+  }
+  return iter;
+}
+
+// A node linked in between prev and next keeps next as its successor, so
+// while the range stays in order no successor is ever looked up.
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename InputIt>
+void Tree<K, V, C, A, R>::AppendSorted_(InputIt first, InputIt last,
+                                        bool unique) {
+  Node_ *prev = root_ ? FindMax(root_) : nullptr;
+  Node_ *next = nullptr;
+  for (; first != last; ++first) {
+    const value_type &elem = *first;
+    Node_ *node = LinkBetween_(prev, next, elem, unique);
+    if (!node) {
+      Iterator iter;
+      bool is_inserted = false;
+      InsertInto_(elem, iter, is_inserted, unique);
+      node = iter.GetNode();
+      next = Next_(node);
     }
-    left_->Insert_(elem, iter, is_inserted);
-  } else if (elem.first > root_->element_.first) {
-    if (!right_) {
-      right_ = new Tree;
-      right_->parent_ = this;
+    prev = node;
+  }
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename... Args>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::CreateNode_(
+    Node_ *parent, Args &&...args) {
+  Grow_(1);
+  Node_ *node = NodeTraits_::allocate(alloc_, 1);
+  try {
+    NodeTraits_::construct(alloc_, node, parent, std::forward<Args>(args)...);
+  } catch (...) {
+    NodeTraits_::deallocate(alloc_, node, 1);
+    throw;
+  }
+  ++size_;
+  return node;
+}
+
+// Throws before size_ can go past max_size(), which with R would wrap the
+// subtree counts.
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::Grow_(size_type more) const {
+  if (more > max_size() - size_) throw std::length_error("Tree is too large");
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::DestroyNode_(Node_ *node) noexcept {
+  NodeTraits_::destroy(alloc_, node);
+  NodeTraits_::deallocate(alloc_, node, 1);
+}
+
+// Makes a node of our own for each of nodes, which belong to a tree with an
+// unequal allocator, all or nothing. Every node is allocated before any
+// element moves, and an element is moved only when that cannot throw or it
+// cannot be copied, as std::move_if_noexcept decides; otherwise it is
+// copied. So if anything throws, the new nodes are freed and the old ones
+// still hold their elements. The old nodes are left for the caller to free,
+// and size_ is left alone.
+template <typename K, typename V, typename C, typename A, bool R>
+std::vector<typename Tree<K, V, C, A, R>::Node_ *> Tree<K, V, C, A, R>::Adopt_(
+    const std::vector<Node_ *> &nodes) {
+  std::vector<Node_ *> fresh;
+  fresh.reserve(nodes.size());
+  size_type built = 0;
+  try {
+    for (size_type i = 0; i < nodes.size(); ++i)
+      fresh.push_back(NodeTraits_::allocate(alloc_, 1));
+    for (; built < nodes.size(); ++built)
+      NodeTraits_::construct(alloc_, fresh[built], nullptr,
+                             std::move_if_noexcept(nodes[built]->element_));
+  } catch (...) {
+    for (size_type i = 0; i < fresh.size(); ++i) {
+      if (i < built) NodeTraits_::destroy(alloc_, fresh[i]);
+      NodeTraits_::deallocate(alloc_, fresh[i], 1);
     }
-    right_->Insert_(elem, iter, is_inserted);
+    throw;
   }
-  Balance_();
+  return fresh;
 }
 
-template <typename K, typename V>
-Tree<K, V> *Tree<K, V>::FindMin(const Tree *node) const {
-  return (node->left_ && node->left_->root_ ? FindMin(node->left_)
-                                            : (Tree<K, V> *)node);
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::FindMin(Node_ *node) {
+  while (node->left_) node = node->left_;
+  return node;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::erase(Tree<K, V>::Iterator pos) {
-  Tree<K, V> *current = GetTree_(pos);
-  if (current == this) {
-    RemoveThis_(current);
-  } else {
-    auto parent = current->parent_;
-    if (!current->left_ && !current->right_) {
-      RemoveEdge_(current, parent);
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::FindMax(Node_ *node) {
+  while (node->right_) node = node->right_;
+  return node;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::Next_(Node_ *node) {
+  if (node->right_) return FindMin(node->right_);
+  while (node->parent_ && node->parent_->right_ == node) node = node->parent_;
+  return node->parent_;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::Prev_(Node_ *node) {
+  if (node->left_) return FindMax(node->left_);
+  while (node->parent_ && node->parent_->left_ == node) node = node->parent_;
+  return node->parent_;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::Select_(
+    Node_ *node, size_type index) {
+  while (true) {
+    size_type left = Count_(node->left_);
+    if (index < left) {
+      node = node->left_;
+    } else if (index == left) {
+      return node;
     } else {
-      RemoveNode_(current, parent);
+      index -= left + 1;
+      node = node->right_;
     }
   }
-  if (root_) Balance_();
 }
 
-template <typename K, typename V>
-void Tree<K, V>::Size_(int &size) const noexcept {
-  if (root_) ++size;
-  if (right_) right_->Size_(size);
-  if (left_) left_->Size_(size);
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::Advance_(
+    Node_ *node, difference_type offset) {
+  // An offset past the largest element gives nullptr, that is end(); one
+  // before the smallest stops at the smallest. Without R the node steps
+  // there one element at a time.
+  if constexpr (!R) {
+    for (; node && offset > 0; --offset) node = Next_(node);
+    for (Node_ *prev; offset < 0 && (prev = Prev_(node)); ++offset)
+      node = prev;
+    return node;
+  }
+  // With R it climbs until the subtree holds the target, then selects it by
+  // index.
+  difference_type index = Count_(node->left_) + offset;
+  while (node->parent_ &&
+         (index < 0 || index >= static_cast<difference_type>(node->count_))) {
+    if (node->parent_->right_ == node)
+      index += Count_(node->parent_->left_) + 1;
+    node = node->parent_;
+  }
+  if (index < 0) index = 0;
+  if (index >= static_cast<difference_type>(node->count_)) return nullptr;
+  return Select_(node, index);
 }
 
-template <typename K, typename V>
-Tree<K, V> *Tree<K, V>::FindMax(const Tree *node) const {
-  return (node->right_ && node->right_->root_ ? FindMax(node->right_)
-                                              : (Tree<K, V> *)node);
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::Transplant_(Node_ *node, Node_ *child) {
+  ReplaceChild_(node->parent_, node, child);
+  if (child) child->parent_ = node->parent_;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::clear() noexcept {
-  delete left_;
-  delete right_;
-  delete root_;
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::erase(Tree<K, V, C, A, R>::Iterator pos) {
+  Node_ *node = pos.GetNode();
+  if (!node) return;
+  Unlink_(node);
+  DestroyNode_(node);
 }
 
-template <typename K, typename V>
-void Tree<K, V>::Swap_(Tree<K, V> &other) {
-  Node_ *tmp_root = root_;
-  Tree<K, V> *tmp_left = left_;
-  Tree<K, V> *tmp_right = right_;
-  Tree<K, V> *tmp_parent = parent_;
-  root_ = other.root_;
-  left_ = other.left_;
-  right_ = other.right_;
-  parent_ = other.parent_;
-  other.root_ = tmp_root;
-  other.left_ = tmp_left;
-  other.right_ = tmp_right;
-  other.parent_ = tmp_parent;
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::Unlink_(Node_ *node) {
+  Node_ *retrace = node->parent_;
+  if (!node->left_) {
+    Transplant_(node, node->right_);
+  } else if (!node->right_) {
+    Transplant_(node, node->left_);
+  } else {
+    Node_ *next = FindMin(node->right_);
+    if (next->parent_ != node) {
+      retrace = next->parent_;
+      Transplant_(next, next->right_);
+      next->right_ = node->right_;
+      next->right_->parent_ = next;
+    } else {
+      retrace = next;
+    }
+    Transplant_(node, next);
+    next->left_ = node->left_;
+    next->left_->parent_ = next;
+    // next stands in for node, so the retrace sees node's old height and
+    // count at that position.
+    next->height_ = node->height_;
+    next->count_ = node->count_;
+  }
+  --size_;
+  Retrace_(retrace, false);
 }
 
-template <typename K, typename V>
-void Tree<K, V>::RemoveThis_(Tree<K, V> *current) {
-  if (current->right_ || current->left_) {
-    Tree<K, V> *min =
-        FindMin(current->right_ ? current->right_ : current->left_);
-    Tree<K, V> *min_parent = min->parent_;
-    if (min_parent->left_ == min)
-      min_parent->left_ = nullptr;
-    else
-      min_parent->right_ = nullptr;
-    min->parent_ = nullptr;
-    if (left_) {
-      min->left_ = left_;
-      left_ = nullptr;
-    }
-    if (right_) {
-      min->right_ = right_;
-      right_ = nullptr;
-    }
-    Swap_(*min);
-    if (right_) right_->parent_ = this;
-    delete min;
-  } else {
-    delete root_;
-    root_ = nullptr;
+// Rebalances from node towards the root while subtree heights keep changing.
+// Once a subtree comes out as tall as it was, nothing above it needs a
+// rotation; with R the remaining ancestors still have their element count
+// adjusted by the one node that was added or removed.
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::Retrace_(Node_ *node, bool grown) {
+  while (node) {
+    unsigned char height = node->height_;
+    node = Balance_(node);
+    bool settled = node->height_ == height;
+    node = node->parent_;
+    if (settled) break;
+  }
+  if constexpr (R) {
+    for (; node; node = node->parent_) {
+      if (grown)
+        ++node->count_;
+      else
+        --node->count_;
+    }
   }
 }
 
-template <typename K, typename V>
-void Tree<K, V>::RemoveEdge_(Tree<K, V> *current, Tree<K, V> *parent) {
-  if (parent->left_ == current) {
-    delete current;
-    parent->left_ = nullptr;
-  } else if (parent->right_ == current) {
-    delete current;
-    parent->right_ = nullptr;
+// Frees the subtree bottom up without a stack: descends to a leaf, frees
+// it, detaches it from its parent and carries on from the parent.
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::Destroy_(Node_ *node) {
+  if (!node) return;
+  Node_ *stop = node->parent_;
+  while (node != stop) {
+    if (node->left_) {
+      node = node->left_;
+    } else if (node->right_) {
+      node = node->right_;
+    } else {
+      Node_ *parent = node->parent_;
+      if (parent != stop) {
+        if (parent->left_ == node)
+          parent->left_ = nullptr;
+        else
+          parent->right_ = nullptr;
+      }
+      DestroyNode_(node);
+      node = parent;
+    }
   }
 }
 
-template <typename K, typename V>
-void Tree<K, V>::RemoveNode_(Tree<K, V> *current, Tree<K, V> *parent) {
-  Tree<K, V> *min = FindMin(current->right_ ? current->right_ : current->left_);
-  Tree<K, V> *min_parent = min->parent_;
-  if (min_parent->right_ == min)
-    min_parent->right_ = nullptr;
-  else
-    min_parent->left_ = nullptr;
-  if (parent->right_ == current)
-    parent->right_ = min;
-  else
-    parent->left_ = min;
-  min->left_ = current->left_;
-  min->right_ = current->right_;
-  min->parent_ = parent;
-  if (min->left_) min->left_->parent_ = min;
-  if (min->right_) min->right_->parent_ = min;
-  current->left_ = nullptr;
-  current->right_ = nullptr;
-  current->parent_ = nullptr;
-  delete current;
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::clear() noexcept {
+  Destroy_(root_);
+  root_ = nullptr;
+  size_ = 0;
 }
 
-template <typename K, typename V>
-bool Tree<K, V>::empty() const noexcept {
-  return !root_;
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::Swap_(Tree<K, V, C, A, R> &other) {
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+  std::swap(alloc_, other.alloc_);
+  std::swap(comp_, other.comp_);
 }
 
-template <typename K, typename V>
-typename Tree<K, V>::size_type Tree<K, V>::max_size() const noexcept {
-  return std::numeric_limits<size_type>::max() / sizeof(Tree<V, V>) / 2;
+template <typename K, typename V, typename C, typename A, bool R>
+bool Tree<K, V, C, A, R>::empty() const noexcept {
+  return !size_;
 }
 
-template <typename K, typename V>
-Tree<K, V>::Tree(const std::initializer_list<value_type> &items)
-    : root_(nullptr), parent_(nullptr), left_(nullptr), right_(nullptr) {
-  for (value_type i : items) insert(i);
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::size_type Tree<K, V, C, A, R>::max_size()
+    const noexcept {
+  size_type max = NodeTraits_::max_size(alloc_);
+  if constexpr (R)
+    max = std::min<size_type>(max, std::numeric_limits<std::uint32_t>::max());
+  return max;
 }
 
-template <typename K, typename V>
-Tree<K, V> &Tree<K, V>::operator=(const Tree &other) noexcept {
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::allocator_type
+Tree<K, V, C, A, R>::get_allocator() const {
+  return allocator_type(alloc_);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+Tree<K, V, C, A, R>::Tree(const std::initializer_list<value_type> &items)
+    : root_(nullptr), size_(0), alloc_(), comp_() {
+  Assign_(items.begin(), items.end(), true);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename InputIt, typename>
+Tree<K, V, C, A, R>::Tree(InputIt first, InputIt last)
+    : root_(nullptr), size_(0), alloc_(), comp_() {
+  Assign_(first, last, true);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename InputIt>
+void Tree<K, V, C, A, R>::assign(InputIt first, InputIt last) {
+  Assign_(first, last, true);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename InputIt>
+void Tree<K, V, C, A, R>::Assign_(InputIt first, InputIt last, bool unique) {
+  clear();
+  std::vector<Node_ *> nodes;
+  bool is_sorted = true;
+  try {
+    for (; first != last; ++first) {
+      // The slot comes first so that a node is never made with nowhere to
+      // keep it.
+      nodes.push_back(nullptr);
+      nodes.back() = CreateNode_(nullptr, *first);
+      if (nodes.size() > 1 &&
+          comp_(Key_(nodes.back()), Key_(nodes[nodes.size() - 2])))
+        is_sorted = false;
+    }
+  } catch (...) {
+    // The tree is left empty rather than holding the nodes made so far.
+    for (Node_ *node : nodes)
+      if (node) DestroyNode_(node);
+    size_ = 0;
+    throw;
+  }
+  // Unsorted input is sorted once instead of paying a descent and
+  // rebalancing per element; stable order keeps the first of equal keys.
+  if (!is_sorted)
+    std::stable_sort(nodes.begin(), nodes.end(),
+                     [this](const Node_ *a, const Node_ *b) {
+                       return comp_(Key_(a), Key_(b));
+                     });
+  if (unique) {
+    size_type kept = 0;
+    for (Node_ *node : nodes) {
+      if (kept && !comp_(Key_(nodes[kept - 1]), Key_(node)))
+        DestroyNode_(node);
+      else
+        nodes[kept++] = node;
+    }
+    nodes.resize(kept);
+  }
+  Rebuild_(nodes);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::Build_(
+    const std::vector<Node_ *> &nodes, size_type first, size_type last,
+    Node_ *parent) {
+  if (first == last) return nullptr;
+  size_type middle = first + (last - first) / 2;
+  Node_ *node = nodes[middle];
+  node->parent_ = parent;
+  node->left_ = Build_(nodes, first, middle, node);
+  node->right_ = Build_(nodes, middle + 1, last, node);
+  FixNode_(node);
+  return node;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+std::vector<typename Tree<K, V, C, A, R>::Node_ *>
+Tree<K, V, C, A, R>::Flatten_() const {
+  std::vector<Node_ *> nodes;
+  nodes.reserve(size_);
+  if (root_)
+    for (Node_ *node = FindMin(root_); node; node = Next_(node))
+      nodes.push_back(node);
+  return nodes;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::Rebuild_(const std::vector<Node_ *> &nodes) {
+  root_ = Build_(nodes, 0, nodes.size(), nullptr);
+  size_ = nodes.size();
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::Clone_(
+    const Node_ *node, Node_ *parent) {
+  if (!node) return nullptr;
+  // Walks the source in preorder through its parent links, keeping copy on
+  // the matching node of the clone; a missing child of copy is not yet
+  // cloned.
+  auto copy_node = [this](const Node_ *src, Node_ *parent) {
+    Node_ *copy = CreateNode_(parent, src->element_);
+    copy->height_ = src->height_;
+    copy->count_ = src->count_;
+    return copy;
+  };
+  size_type size = size_;
+  Node_ *root = copy_node(node, parent);
+  Node_ *copy = root;
+  try {
+    for (const Node_ *src = node;;) {
+      if (src->left_ && !copy->left_) {
+        src = src->left_;
+        copy->left_ = copy_node(src, copy);
+        copy = copy->left_;
+      } else if (src->right_ && !copy->right_) {
+        src = src->right_;
+        copy->right_ = copy_node(src, copy);
+        copy = copy->right_;
+      } else if (src == node) {
+        return root;
+      } else {
+        src = src->parent_;
+        copy = copy->parent_;
+      }
+    }
+  } catch (...) {
+    // Children are linked as they are made, so the part of the clone built
+    // so far is a tree of its own.
+    Destroy_(root);
+    size_ = size;
+    throw;
+  }
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+Tree<K, V, C, A, R> &Tree<K, V, C, A, R>::operator=(const Tree &other) {
   if (this != &other) {
-    auto it = other.begin();
     clear();
-    root_ = nullptr;
-    parent_ = nullptr;
-    left_ = nullptr;
-    right_ = nullptr;
-    std::pair<K, V> el;
-    el.first = it->first;
-    el.second = it->second;
-    insert(el);
-    while (true) {
-      if (it == other.end()) break;
-      ++it;
-      el.first = it->first;
-      el.second = it->second;
-      insert(el);
-    }
+    comp_ = other.comp_;
+    root_ = Clone_(other.root_, nullptr);
   }
   return *this;
 }
 
-template <typename K, typename V>
-Tree<K, V>::Tree(const Tree &other) noexcept
-    : root_(nullptr), parent_(nullptr), left_(nullptr), right_(nullptr) {
+template <typename K, typename V, typename C, typename A, bool R>
+Tree<K, V, C, A, R>::Tree(const Tree &other)
+    : root_(nullptr),
+      size_(0),
+      alloc_(NodeTraits_::select_on_container_copy_construction(
+          other.alloc_)),
+      comp_(other.comp_) {
   *this = other;
 }
 
-template <typename K, typename V>
-Tree<K, V>::Tree(Tree &&other) noexcept {
-  *this = std::move(other);
+template <typename K, typename V, typename C, typename A, bool R>
+Tree<K, V, C, A, R>::Tree(Tree &&other) noexcept
+    : root_(nullptr), size_(0), alloc_(other.alloc_), comp_(other.comp_) {
+  Swap_(other);
 }
 
-template <typename K, typename V>
-void Tree<K, V>::merge(Tree<K, V> &other) {
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::merge(Tree<K, V, C, A, R> &other) {
+  Merge_(other, true);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::Merge_(Tree &other, bool unique) {
+  if (this == &other || !other.root_) return;
+  // Checked before anything moves, so keys other shares with a unique tree
+  // still count.
+  Grow_(other.size_);
+  std::vector<Node_ *> lhs = Flatten_();
+  std::vector<Node_ *> rhs = other.Flatten_();
+  std::vector<Node_ *> nodes, taken;
+  nodes.reserve(lhs.size() + rhs.size());
+  taken.reserve(rhs.size());
+  size_type i = 0, j = 0;
+  // Ties take the node of *this first, as std::multiset::merge does; a unique
+  // tree drops the node of other instead.
+  while (i < lhs.size() && j < rhs.size()) {
+    if (comp_(Key_(rhs[j]), Key_(lhs[i]))) {
+      nodes.push_back(rhs[j]);
+      taken.push_back(rhs[j++]);
+    } else if (unique && !comp_(Key_(lhs[i]), Key_(rhs[j]))) {
+      ++j;
+    } else {
+      nodes.push_back(lhs[i++]);
+    }
+  }
+  nodes.insert(nodes.end(), lhs.begin() + i, lhs.end());
+  nodes.insert(nodes.end(), rhs.begin() + j, rhs.end());
+  taken.insert(taken.end(), rhs.begin() + j, rhs.end());
+  // Nothing has changed yet, and nothing of other is freed until the nodes
+  // taken from it have places of our own, so a throw leaves both trees as
+  // they were. With unequal allocators every node of other goes in the end.
+  bool relink = alloc_ == other.alloc_;
+  if (!relink) {
+    std::vector<Node_ *> fresh = Adopt_(taken);
+    size_type k = 0;
+    for (Node_ *&node : nodes)
+      if (k < taken.size() && node == taken[k]) node = fresh[k++];
+  }
+  size_type k = 0;
+  for (Node_ *node : rhs) {
+    if (relink && k < taken.size() && node == taken[k])
+      ++k;
+    else
+      other.DestroyNode_(node);
+  }
+  other.root_ = nullptr;
+  other.size_ = 0;
+  Rebuild_(nodes);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::unite(const Tree &other) {
+  if (this == &other || !other.root_) return;
+  std::vector<Node_ *> lhs = Flatten_();
+  std::vector<Node_ *> rhs = other.Flatten_();
+  std::vector<Node_ *> nodes;
+  nodes.reserve(lhs.size() + rhs.size());
+  size_type i = 0, j = 0;
+  try {
+    while (i < lhs.size() && j < rhs.size()) {
+      int res = Compare_(Key_(lhs[i]), Key_(rhs[j]));
+      if (res > 0) {
+        nodes.push_back(CreateNode_(nullptr, rhs[j++]->element_));
+      } else {
+        if (!res) ++j;
+        nodes.push_back(lhs[i++]);
+      }
+    }
+    nodes.insert(nodes.end(), lhs.begin() + i, lhs.end());
+    for (; j < rhs.size(); ++j)
+      nodes.push_back(CreateNode_(nullptr, rhs[j]->element_));
+  } catch (...) {
+    // The tree is still linked as it was; only the copies go. nodes was
+    // reserved in full, so every copy made is in it, after or among the
+    // nodes of lhs in order.
+    size_type kept = 0;
+    for (Node_ *node : nodes) {
+      if (kept < lhs.size() && node == lhs[kept]) {
+        ++kept;
+      } else {
+        DestroyNode_(node);
+        --size_;
+      }
+    }
+    throw;
+  }
+  Rebuild_(nodes);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::intersect(const Tree &other) {
+  if (this == &other) return;
+  std::vector<Node_ *> lhs = Flatten_();
+  std::vector<Node_ *> rhs = other.Flatten_();
+  std::vector<Node_ *> nodes;
+  size_type i = 0, j = 0;
+  while (i < lhs.size() && j < rhs.size()) {
+    int res = Compare_(Key_(lhs[i]), Key_(rhs[j]));
+    if (res < 0) {
+      DestroyNode_(lhs[i++]);
+    } else if (res > 0) {
+      ++j;
+    } else {
+      nodes.push_back(lhs[i++]);
+      ++j;
+    }
+  }
+  for (; i < lhs.size(); ++i) DestroyNode_(lhs[i]);
+  Rebuild_(nodes);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::subtract(const Tree &other) {
+  if (this == &other) {
+    clear();
+    return;
+  }
   if (!other.root_) return;
-  auto itr1 = other.begin();
-  std::pair<K, V> sorry;
-  for (; itr1 != other.end(); itr1++) {
-    sorry.first = itr1->first;
-    sorry.second = itr1->second;
-    insert(sorry);
-  }
-  sorry.first = itr1->first;
-  sorry.second = itr1->second;
-  insert(sorry);
-  other.clear();
+  std::vector<Node_ *> lhs = Flatten_();
+  std::vector<Node_ *> rhs = other.Flatten_();
+  std::vector<Node_ *> nodes;
+  size_type i = 0, j = 0;
+  while (i < lhs.size() && j < rhs.size()) {
+    int res = Compare_(Key_(lhs[i]), Key_(rhs[j]));
+    if (res < 0) {
+      nodes.push_back(lhs[i++]);
+    } else if (res > 0) {
+      ++j;
+    } else {
+      DestroyNode_(lhs[i++]);
+      ++j;
+    }
+  }
+  nodes.insert(nodes.end(), lhs.begin() + i, lhs.end());
+  Rebuild_(nodes);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::JoinNodes_(
+    Node_ *left, Node_ *mid, Node_ *right) {
+  // Hangs mid off the spine of the taller tree where the heights meet, then
+  // retraces that spine. The result is left in root_ and returned.
+  if (left) left->parent_ = nullptr;
+  if (right) right->parent_ = nullptr;
+  bool left_taller = Height_(left) >= Height_(right);
+  Node_ *shorter = left_taller ? right : left;
+  Node_ *parent = nullptr;
+  Node_ *node = left_taller ? left : right;
+  root_ = node;
+  while (Height_(node) > Height_(shorter) + 1) {
+    parent = node;
+    node = left_taller ? node->right_ : node->left_;
+  }
+  mid->left_ = left_taller ? node : shorter;
+  mid->right_ = left_taller ? shorter : node;
+  if (mid->left_) mid->left_->parent_ = mid;
+  if (mid->right_) mid->right_->parent_ = mid;
+  mid->parent_ = parent;
+  if (!parent)
+    root_ = mid;
+  else if (left_taller)
+    parent->right_ = mid;
+  else
+    parent->left_ = mid;
+  FixNode_(mid);
+  while (parent) parent = Balance_(parent)->parent_;
+  return root_;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::split(const K &key, Tree &greater) {
+  SplitBy_(greater, [this, &key](const Node_ *node) {
+    return comp_(Key_(node), key);
+  });
+  if constexpr (!R) SizeHalves_(greater);
+}
+
+// goes_less is asked about each node on one path down from the root, in
+// order, and tells whether it belongs to the lower half. Without R the
+// halves are left for the caller to size: size_ still holds the total and
+// greater.size_ is 0.
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename F>
+void Tree<K, V, C, A, R>::SplitBy_(Tree &greater, F goes_less) {
+  if (this == &greater) return;
+  greater.clear();
+  // The nodes change trees without being copied, so greater shares our
+  // allocator from here on.
+  greater.alloc_ = alloc_;
+  greater.comp_ = comp_;
+  std::vector<Node_ *> less_path, greater_path;
+  for (Node_ *node = root_; node;) {
+    if (goes_less(node)) {
+      less_path.push_back(node);
+      node = node->right_;
+    } else {
+      greater_path.push_back(node);
+      node = node->left_;
+    }
+  }
+  // Every node on the search path is rejoined, deepest first, with the
+  // subtree hanging off the side of the path that stays in its half.
+  Node_ *less = nullptr;
+  for (auto it = less_path.rbegin(); it != less_path.rend(); ++it)
+    less = JoinNodes_((*it)->left_, *it, less);
+  Node_ *more = nullptr;
+  for (auto it = greater_path.rbegin(); it != greater_path.rend(); ++it)
+    more = JoinNodes_(more, *it, (*it)->right_);
+  root_ = less;
+  greater.root_ = more;
+  if constexpr (R) {
+    size_ = Count_(less);
+    greater.size_ = Count_(more);
+  }
+}
+
+// *this and greater hold size_ elements between them. Both are walked in
+// order at once until one runs out, so the cost is that of the smaller.
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::SizeHalves_(Tree &greater) {
+  size_type total = size_ + greater.size_;
+  size_type steps = 0;
+  Node_ *less = root_ ? FindMin(root_) : nullptr;
+  Node_ *more = greater.root_ ? FindMin(greater.root_) : nullptr;
+  for (; less && more; ++steps) {
+    less = Next_(less);
+    more = Next_(more);
+  }
+  size_ = less ? total - steps : steps;
+  greater.size_ = total - size_;
+}
+
+// The elements from last on go to a tree of their own, those from first on
+// to out, and the two ends are joined again. Each cut follows the path from
+// the root to its node, whose ancestors tell on which side of it they lie.
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::ExtractRange_(Node_ *first, Node_ *last,
+                                        Tree &out) {
+  auto before = [](const Node_ *node) {
+    std::vector<const Node_ *> path;
+    for (; node; node = node->parent_) path.push_back(node);
+    // Asked root first about the ancestors of node, then about node and
+    // the nodes of its left subtree. A null node keeps everything.
+    return [path = std::move(path)](const Node_ *asked) mutable {
+      if (path.empty()) return true;
+      path.pop_back();
+      return !path.empty() && path.back() == asked->right_;
+    };
+  };
+  size_type total = size_;
+  Tree tail(comp_, get_allocator());
+  SplitBy_(tail, before(last));
+  SplitBy_(out, before(first));
+  if constexpr (!R) {
+    for (Node_ *node = FindMin(out.root_); node; node = Next_(node))
+      ++out.size_;
+    size_ = total - out.size_;
+  }
+  Join_(tail, false);
+}
+
+// The range runs from the lower bound of lo to that of hi, and is empty
+// when the latter does not come after the former.
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+void Tree<K, V, C, A, R>::ExtractKeys_(const T &lo, const T &hi, Tree &out) {
+  const LookupKey_<T> &low = lo;
+  const LookupKey_<T> &high = hi;
+  Node_ *first = LowerBound_(low);
+  Node_ *last = LowerBound_(high);
+  if (!first || first == last || (last && comp_(Key_(last), Key_(first))))
+    out.clear();
+  else
+    ExtractRange_(first, last, out);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::iterator Tree<K, V, C, A, R>::erase(
+    const_iterator first, const_iterator last) {
+  if (first != last) {
+    Tree doomed(comp_, get_allocator());
+    ExtractRange_(first.GetNode(), last.GetNode(), doomed);
+  }
+  return Iterator(last.GetNode(), this);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::size_type Tree<K, V, C, A, R>::erase_many(
+    const std::vector<const_iterator> &positions) {
+  if (positions.size() * Height_(root_) < size_) {
+    for (const const_iterator &pos : positions) {
+      Unlink_(pos.GetNode());
+      DestroyNode_(pos.GetNode());
+    }
+    return positions.size();
+  }
+  // The doomed nodes stay linked until the walk is over, since Next_ climbs
+  // through them.
+  std::vector<Node_ *> nodes = Flatten_();
+  size_type kept = 0;
+  auto pos = positions.begin();
+  for (Node_ *node : nodes) {
+    if (pos != positions.end() && pos->GetNode() == node)
+      ++pos;
+    else
+      nodes[kept++] = node;
+  }
+  nodes.resize(kept);
+  for (const const_iterator &doomed : positions) DestroyNode_(doomed.GetNode());
+  Rebuild_(nodes);
+  return positions.size();
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+typename Tree<K, V, C, A, R>::size_type Tree<K, V, C, A, R>::erase_range(
+    const T &lo, const T &hi) {
+  Tree doomed(comp_, get_allocator());
+  ExtractKeys_(lo, hi, doomed);
+  return doomed.size();
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+Tree<K, V, C, A, R> Tree<K, V, C, A, R>::extract_range(const T &lo,
+                                                       const T &hi) {
+  Tree res(comp_, get_allocator());
+  ExtractKeys_(lo, hi, res);
+  return res;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::join(Tree &other) {
+  Join_(other, true);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::Join_(Tree &other, bool unique) {
+  if (this == &other || !other.root_) return;
+  if (root_) {
+    const K &last = Key_(FindMax(root_));
+    const K &first = Key_(FindMin(other.root_));
+    if (comp_(first, last) || (unique && !comp_(last, first)))
+      throw std::invalid_argument("Key ranges overlap");
+  }
+  Grow_(other.size_);
+  size_type count = size_ + other.size_;
+  if (!(alloc_ == other.alloc_)) {
+    // A node can only be freed by an allocator equal to the one that made
+    // it, so other's elements go into nodes of our own first. Until all of
+    // them are built other is untouched, so a throw leaves both trees whole.
+    std::vector<Node_ *> nodes = other.Flatten_();
+    std::vector<Node_ *> fresh = Adopt_(nodes);
+    for (Node_ *node : nodes) other.DestroyNode_(node);
+    other.Rebuild_(fresh);
+    other.alloc_ = alloc_;
+  }
+  Node_ *mid = FindMin(other.root_);
+  other.Unlink_(mid);
+  root_ = JoinNodes_(root_, mid, other.root_);
+  size_ = count;
   other.root_ = nullptr;
-  other.right_ = nullptr;
-  other.left_ = nullptr;
-  other.parent_ = nullptr;
+  other.size_ = 0;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::swap(Tree &other) {
+template <typename K, typename V, typename C, typename A, bool R>
+void Tree<K, V, C, A, R>::swap(Tree &other) {
   Swap_(other);
 }
 
-template <typename K, typename V>
-std::pair<typename Tree<K, V>::iterator, bool> Tree<K, V>::insert(
-    const Tree::value_type &value) noexcept {
+template <typename K, typename V, typename C, typename A, bool R>
+std::pair<typename Tree<K, V, C, A, R>::iterator, bool>
+Tree<K, V, C, A, R>::insert(const Tree::value_type &value) {
   iterator it;
   bool is_inserted = false;
   Insert_(value, it, is_inserted);
@@ -598,28 +1679,336 @@ std::pair<typename Tree<K, V>::iterator, bool> Tree<K, V>::insert(
   return res;
 }
 
-template <typename K, typename V>
-bool Tree<K, V>::contains(const K &key) const noexcept {
-  bool contains = true;
-  Contains_(key, contains);
-  return contains;
+template <typename K, typename V, typename C, typename A, bool R>
+std::pair<typename Tree<K, V, C, A, R>::iterator, bool>
+Tree<K, V, C, A, R>::insert(value_type &&value) {
+  iterator it;
+  bool is_inserted = false;
+  InsertInto_(std::move(value), it, is_inserted, true);
+  return {it, is_inserted};
 }
 
-template <typename K, typename V>
-void Tree<K, V>::Contains_(const K &key, bool &contains) const noexcept {
-  if (!root_ || (!left_ && !right_ && root_->element_.first != key)) {
-    contains = false;
-  } else if (key < root_->element_.first) {
-    if (left_)
-      left_->Contains_(key, contains);
-    else
-      contains = false;
-  } else if (key > root_->element_.first) {
-    if (right_)
-      right_->Contains_(key, contains);
-    else
-      contains = false;
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename... Args>
+std::pair<typename Tree<K, V, C, A, R>::iterator, bool>
+Tree<K, V, C, A, R>::emplace(Args &&...args) {
+  return Emplace_(true, std::forward<Args>(args)...);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename... Args>
+std::vector<std::pair<typename Tree<K, V, C, A, R>::iterator, bool>>
+Tree<K, V, C, A, R>::insert_many(Args &&...args) {
+  std::vector<std::pair<iterator, bool>> res_vec;
+  res_vec.reserve(sizeof...(args));
+  (res_vec.push_back(insert(std::forward<Args>(args))), ...);
+  return res_vec;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::iterator Tree<K, V, C, A, R>::insert(
+    const_iterator hint, const value_type &value) {
+  return HintInsert_(hint, value, true);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::iterator Tree<K, V, C, A, R>::insert(
+    const_iterator hint, value_type &&value) {
+  return HintInsert_(hint, std::move(value), true);
+}
+
+// The hinted path needs the key before a node exists, so the element is
+// built once here and moved into its node.
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename... Args>
+typename Tree<K, V, C, A, R>::iterator Tree<K, V, C, A, R>::emplace_hint(
+    const_iterator hint, Args &&...args) {
+  return HintInsert_(hint, value_type(std::forward<Args>(args)...), true);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename InputIt>
+void Tree<K, V, C, A, R>::append_sorted(InputIt first, InputIt last) {
+  AppendSorted_(first, last, true);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::node_type Tree<K, V, C, A, R>::extract(
+    const_iterator pos) {
+  Node_ *node = pos.GetNode();
+  if (!node) return node_type();
+  Unlink_(node);
+  return node_type(node, alloc_);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::node_type Tree<K, V, C, A, R>::extract(
+    const K &key) {
+  Node_ *node = LowerBound_(key);
+  if (!node || comp_(key, Key_(node))) return node_type();
+  return extract(const_iterator(node, this));
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::insert_return_type Tree<K, V, C, A, R>::insert(
+    node_type &&node) {
+  std::pair<iterator, bool> res = InsertNode_(node, true);
+  return {res.first, res.second, std::move(node)};
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::iterator Tree<K, V, C, A, R>::insert(
+    const_iterator hint, node_type &&node) {
+  return HintInsertNode_(hint, node, true);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+std::pair<typename Tree<K, V, C, A, R>::Iterator, bool>
+Tree<K, V, C, A, R>::InsertNode_(NodeHandle &nh, bool unique) {
+  if (nh.empty()) return {end(), false};
+  Node_ *parent;
+  bool left;
+  Node_ *found = FindSlot_(nh.key(), unique, parent, left);
+  if (found) return {Iterator(found, this), false};
+  return {Iterator(LinkHandle_(nh, parent, left), this), true};
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Iterator Tree<K, V, C, A, R>::HintInsertNode_(
+    ConstIterator hint, NodeHandle &nh, bool unique) {
+  if (nh.empty()) return end();
+  Node_ *next = hint.GetNode();
+  Node_ *prev = next ? Prev_(next) : (root_ ? FindMax(root_) : nullptr);
+  if (!Fits_(prev, next, nh.key(), unique))
+    return InsertNode_(nh, unique).first;
+  bool left = !prev || prev->right_;
+  return Iterator(LinkHandle_(nh, left ? next : prev, left), this);
+}
+
+// The node is reset to a fresh leaf, since Unlink_ left its old links and
+// subtree counts in place.
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::LinkHandle_(
+    NodeHandle &nh, Node_ *parent, bool left) {
+  Node_ *node = nh.node_;
+  if (nh.alloc_ == alloc_) {
+    Grow_(1);
+    node->parent_ = parent;
+    node->left_ = node->right_ = nullptr;
+    node->height_ = 1;
+    node->count_ = 1;
+    nh.node_ = nullptr;
+    ++size_;
+  } else {
+    node = CreateNode_(parent, std::move(node->element_));
+    nh.Reset_();
   }
+  Attach_(node, left);
+  return node;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+bool Tree<K, V, C, A, R>::contains(const T &key) const {
+  const LookupKey_<T> &lookup = key;
+  return Find_(lookup) != nullptr;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::Find_(
+    const T &key) const {
+  if constexpr (HasThreeWay<C, T, K>::value) {
+    Node_ *node = root_;
+    while (node) {
+      int res = Compare_(key, Key_(node));
+      if (!res) break;
+      node = res < 0 ? node->left_ : node->right_;
+    }
+    return node;
+  } else {
+    // One comparison per level down to the lower bound, and one more to see
+    // whether it holds key.
+    Node_ *node = LowerBound_(key);
+    return node && !comp_(key, Key_(node)) ? node : nullptr;
+  }
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::LowerBound_(
+    const T &key) const {
+  Node_ *node = root_;
+  Node_ *bound = nullptr;
+  while (node) {
+    if (comp_(Key_(node), key)) {
+      node = node->right_;
+    } else {
+      bound = node;
+      node = node->left_;
+    }
+  }
+  return bound;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+typename Tree<K, V, C, A, R>::Node_ *Tree<K, V, C, A, R>::UpperBound_(
+    const T &key) const {
+  Node_ *node = root_;
+  Node_ *bound = nullptr;
+  while (node) {
+    if (comp_(key, Key_(node))) {
+      bound = node;
+      node = node->left_;
+    } else {
+      node = node->right_;
+    }
+  }
+  return bound;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+typename Tree<K, V, C, A, R>::iterator Tree<K, V, C, A, R>::find(
+    const T &key) const {
+  const LookupKey_<T> &lookup = key;
+  return Iterator(Find_(lookup), this);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+typename Tree<K, V, C, A, R>::iterator Tree<K, V, C, A, R>::lower_bound(
+    const T &key) const {
+  const LookupKey_<T> &lookup = key;
+  return Iterator(LowerBound_(lookup), this);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+typename Tree<K, V, C, A, R>::iterator Tree<K, V, C, A, R>::upper_bound(
+    const T &key) const {
+  const LookupKey_<T> &lookup = key;
+  return Iterator(UpperBound_(lookup), this);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+std::pair<typename Tree<K, V, C, A, R>::iterator,
+          typename Tree<K, V, C, A, R>::iterator>
+Tree<K, V, C, A, R>::equal_range(const T &key) const {
+  const LookupKey_<T> &lookup = key;
+  return {Iterator(LowerBound_(lookup), this),
+          Iterator(UpperBound_(lookup), this)};
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+typename Tree<K, V, C, A, R>::iterator Tree<K, V, C, A, R>::nth(
+    size_type k) const {
+  if (k >= size_) throw std::out_of_range("Index out of range");
+  if constexpr (R) {
+    return Iterator(Select_(root_, k), this);
+  } else {
+    // Walks in from whichever end is closer.
+    Node_ *node;
+    if (k < size_ / 2) {
+      for (node = FindMin(root_); k; --k) node = Next_(node);
+    } else {
+      for (node = FindMax(root_), k = size_ - 1 - k; k; --k)
+        node = Prev_(node);
+    }
+    return Iterator(node, this);
+  }
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+std::vector<typename Tree<K, V, C, A, R>::iterator>
+Tree<K, V, C, A, R>::slices(size_type count) const {
+  std::vector<iterator> firsts;
+  if (!root_ || !count) return firsts;
+  if constexpr (R) {
+    if (count > size_) count = size_;
+    firsts.reserve(count);
+    for (size_type i = 0; i < count; ++i)
+      firsts.push_back(Iterator(Select_(root_, size_ * i / count), this));
+  } else {
+    // Each piece is a subtree and the first element of its range, which
+    // runs on through the node above the subtree up to the next piece.
+    // Splitting a piece in two leaves its left subtree in place and adds
+    // the right one after it.
+    std::vector<std::pair<Node_ *, Node_ *>> pieces = {
+        {root_, FindMin(root_)}};
+    while (pieces.size() < count) {
+      size_type tallest = pieces.size();
+      for (size_type i = 0; i < pieces.size(); ++i)
+        if (Height_(pieces[i].first) > 1 &&
+            (tallest == pieces.size() ||
+             Height_(pieces[i].first) > Height_(pieces[tallest].first)))
+          tallest = i;
+      if (tallest == pieces.size()) break;
+      Node_ *node = pieces[tallest].first;
+      pieces[tallest].first = node->left_;
+      if (node->right_)
+        pieces.insert(pieces.begin() + tallest + 1,
+                      {node->right_, FindMin(node->right_)});
+    }
+    firsts.reserve(pieces.size());
+    for (const auto &piece : pieces)
+      firsts.push_back(Iterator(piece.second, this));
+  }
+  return firsts;
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+typename Tree<K, V, C, A, R>::size_type Tree<K, V, C, A, R>::rank(
+    const T &key) const {
+  const LookupKey_<T> &lookup = key;
+  return Rank_(lookup, false);
+}
+
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+typename Tree<K, V, C, A, R>::size_type Tree<K, V, C, A, R>::count(
+    const T &key) const {
+  const LookupKey_<T> &lookup = key;
+  if constexpr (R) {
+    return Rank_(lookup, true) - Rank_(lookup, false);
+  } else {
+    size_type res = 0;
+    for (Node_ *node = LowerBound_(lookup);
+         node && !comp_(lookup, Key_(node)); node = Next_(node))
+      ++res;
+    return res;
+  }
+}
+
+// Number of elements ordered before key, or not ordered after it when
+// inclusive. Without R the elements before the bound are walked and
+// counted.
+template <typename K, typename V, typename C, typename A, bool R>
+template <typename T>
+typename Tree<K, V, C, A, R>::size_type Tree<K, V, C, A, R>::Rank_(
+    const T &key, bool inclusive) const {
+  size_type rank = 0;
+  if constexpr (!R) {
+    Node_ *bound = inclusive ? UpperBound_(key) : LowerBound_(key);
+    for (Node_ *node = root_ ? FindMin(root_) : nullptr; node != bound;
+         node = Next_(node))
+      ++rank;
+    return rank;
+  }
+  for (Node_ *node = root_; node;) {
+    if (inclusive ? !comp_(key, Key_(node)) : comp_(Key_(node), key)) {
+      rank += Count_(node->left_) + 1;
+      node = node->right_;
+    } else {
+      node = node->left_;
+    }
+  }
+  return rank;
 }
 
 }  // namespace s21
+
+#endif  // S21_BINARY_TREE_H_
@@ -0,0 +1,887 @@
+#ifndef S21_BTREE_H_
+#define S21_BTREE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_binary_tree.h"
+
+namespace s21 {
+// B+-tree behind btree_map and btree_set. Elements live only in the leaves,
+// packed in key order and linked into a list for scans; inner nodes hold
+// copies of separator keys, so a lookup touches a few cache lines per level
+// and there are only log_B(n) levels. Insertion and erasure shift elements
+// inside a leaf, so they invalidate every iterator into the tree.
+//
+// Keys are ordered by C, as in Tree. Leaves and inner nodes come from A
+// rebound to each node type, so an allocator sees whole nodes; elements are
+// built in place inside a leaf.
+template <typename K, typename V, typename C = std::less<>,
+          typename A = std::allocator<typename TreeValue<K, V>::type>>
+class BTree {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = typename TreeValue<K, V>::type;
+  using key_compare = C;
+  using allocator_type = A;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // CONSTRUCTORS
+  BTree() noexcept(std::is_nothrow_default_constructible<A>::value &&
+                   std::is_nothrow_default_constructible<C>::value);
+  explicit BTree(const A &alloc);
+  explicit BTree(const C &comp, const A &alloc = A());
+  BTree(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  BTree(InputIt first, InputIt last);
+  BTree(const BTree &other);
+  BTree(BTree &&other) noexcept;
+
+  // DESTRUCTOR
+  virtual ~BTree();
+
+  // BASIC METHODS
+  allocator_type get_allocator() const { return alloc_; }
+  key_compare key_comp() const { return comp_; }
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  void clear() noexcept;
+  void merge(BTree &other);
+  void swap(BTree &other) noexcept;
+  bool contains(const K &key) const;
+
+  // OVERLOAD OPERATORS
+  BTree &operator=(const BTree &other);
+  BTree &operator=(BTree &&other) noexcept;
+
+ protected:
+  // Nodes are sized to about four cache lines; small elements get wide
+  // nodes, large ones never fewer than four slots.
+  static constexpr size_type kNodeBytes = 256;
+  static constexpr size_type kLeafSlots =
+      std::max<size_type>(4, kNodeBytes / sizeof(value_type));
+  static constexpr size_type kInnerSlots =
+      std::max<size_type>(4, kNodeBytes / (sizeof(K) + sizeof(void *)));
+  static constexpr size_type kMinLeaf = kLeafSlots / 2;
+  static constexpr size_type kMinInner = kInnerSlots / 2;
+
+  struct InnerNode_;
+
+  // count_ is the number of elements in a leaf and of keys in an inner node,
+  // which has count_ + 1 children.
+  struct Node_ {
+    InnerNode_ *parent_;
+    std::uint16_t count_;
+    bool leaf_;
+    explicit Node_(bool leaf) : parent_(nullptr), count_(0), leaf_(leaf) {}
+  };
+
+  struct LeafNode_ : Node_ {
+    LeafNode_ *prev_;
+    LeafNode_ *next_;
+    alignas(value_type) unsigned char slots_[kLeafSlots * sizeof(value_type)];
+    LeafNode_() : Node_(true), prev_(nullptr), next_(nullptr) {}
+    value_type *Values() { return reinterpret_cast<value_type *>(slots_); }
+  };
+
+  // Room for one key and child over capacity lets an insertion land before
+  // the node is split.
+  struct InnerNode_ : Node_ {
+    Node_ *children_[kInnerSlots + 2];
+    alignas(K) unsigned char keys_[(kInnerSlots + 1) * sizeof(K)];
+    InnerNode_() : Node_(false) {}
+    K *Keys() { return reinterpret_cast<K *>(keys_); }
+  };
+
+  Node_ *root_;
+  LeafNode_ *head_;
+  LeafNode_ *tail_;
+  size_type size_;
+  A alloc_;
+  C comp_;
+
+  // An iterator is a leaf and a slot in it. end() is the slot past the last
+  // element of the rightmost leaf, and an empty tree has no leaf at all.
+  class ConstIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename BTree::value_type;
+    using difference_type = typename BTree::difference_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    ConstIterator() noexcept : leaf_(nullptr), index_(0) {}
+    ConstIterator(LeafNode_ *leaf, size_type index) noexcept
+        : leaf_(leaf), index_(index) {}
+
+    bool operator==(const ConstIterator &other) const {
+      return leaf_ == other.leaf_ && index_ == other.index_;
+    }
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    }
+    const_reference operator*() const { return leaf_->Values()[index_]; }
+    const value_type *operator->() const { return &leaf_->Values()[index_]; }
+    ConstIterator &operator++() {
+      OperationPlus_();
+      return *this;
+    }
+    ConstIterator operator++(int) {
+      ConstIterator tmp(*this);
+      OperationPlus_();
+      return tmp;
+    }
+    ConstIterator &operator--() {
+      OperationMinus_();
+      return *this;
+    }
+    ConstIterator operator--(int) {
+      ConstIterator tmp(*this);
+      OperationMinus_();
+      return tmp;
+    }
+    LeafNode_ *GetLeaf() const noexcept { return leaf_; }
+    size_type GetIndex() const noexcept { return index_; }
+
+   protected:
+    LeafNode_ *leaf_;
+    size_type index_;
+    void OperationPlus_() {
+      if (++index_ == leaf_->count_ && leaf_->next_) {
+        leaf_ = leaf_->next_;
+        index_ = 0;
+      }
+    }
+    void OperationMinus_() {
+      if (!index_) {
+        leaf_ = leaf_->prev_;
+        index_ = leaf_->count_;
+      }
+      --index_;
+    }
+  };
+
+  class Iterator : public ConstIterator {
+   public:
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    Iterator() noexcept : ConstIterator() {}
+    Iterator(LeafNode_ *leaf, size_type index) noexcept
+        : ConstIterator(leaf, index) {}
+
+    typename BTree::reference operator*() const {
+      return this->leaf_->Values()[this->index_];
+    }
+    value_type *operator->() const {
+      return &this->leaf_->Values()[this->index_];
+    }
+    Iterator &operator++() {
+      this->OperationPlus_();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator tmp(*this);
+      this->OperationPlus_();
+      return tmp;
+    }
+    Iterator &operator--() {
+      this->OperationMinus_();
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator tmp(*this);
+      this->OperationMinus_();
+      return tmp;
+    }
+  };
+
+  static const K &Key_(const value_type &value) noexcept {
+    return TreeValue<K, V>::Key(value);
+  }
+
+  template <typename... Args>
+  std::pair<Iterator, bool> Insert_(const K &key, Args &&...args);
+  LeafNode_ *FindLeaf_(const K &key) const;
+  Iterator Find_(const K &key) const;
+  Iterator LowerBound_(const K &key) const;
+  Iterator UpperBound_(const K &key) const;
+
+ private:
+  template <typename Node>
+  using NodeTraits_ =
+      typename std::allocator_traits<A>::template rebind_traits<Node>;
+
+  template <typename Node>
+  Node *NewNode_();
+  template <typename Node>
+  void DeleteNode_(Node *node) noexcept;
+  size_type LeafLowerBound_(LeafNode_ *leaf, const K &key) const;
+  static size_type ChildIndex_(InnerNode_ *parent, Node_ *child) noexcept;
+  template <typename T>
+  static void MoveSlot_(T *from, T *to);
+  LeafNode_ *SplitLeaf_(LeafNode_ *leaf);
+  void InsertIntoParent_(Node_ *left, const K &key, Node_ *right);
+  void FixLeaf_(LeafNode_ *leaf);
+  void FixInner_(InnerNode_ *node);
+  void MergeLeaves_(LeafNode_ *left, LeafNode_ *right);
+  void MergeInner_(InnerNode_ *left, InnerNode_ *right);
+  static void EraseSlot_(InnerNode_ *node, size_type key_index);
+  void Destroy_(Node_ *node) noexcept;
+  void Build_(const std::vector<const value_type *> &items);
+
+ public:
+  using const_iterator = ConstIterator;
+  using iterator = Iterator;
+
+  iterator begin() const noexcept { return Iterator(head_, 0); }
+  iterator end() const noexcept {
+    return Iterator(tail_, tail_ ? tail_->count_ : 0);
+  }
+
+  void erase(iterator pos);
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  // emplace returns the element holding the key, as insert does;
+  // insert_many inserts each argument in turn.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+
+  // LOOKUP
+  // Unlike Tree, find returns end() for a missing key.
+  iterator find(const K &key) const;
+  iterator lower_bound(const K &key) const;
+  iterator upper_bound(const K &key) const;
+  std::pair<iterator, iterator> equal_range(const K &key) const;
+};
+
+template <typename K, typename V, typename C, typename A>
+BTree<K, V, C, A>::BTree() noexcept(
+    std::is_nothrow_default_constructible<A>::value &&
+    std::is_nothrow_default_constructible<C>::value)
+    : root_(nullptr),
+      head_(nullptr),
+      tail_(nullptr),
+      size_(0),
+      alloc_(),
+      comp_() {}
+
+template <typename K, typename V, typename C, typename A>
+BTree<K, V, C, A>::BTree(const A &alloc)
+    : root_(nullptr),
+      head_(nullptr),
+      tail_(nullptr),
+      size_(0),
+      alloc_(alloc),
+      comp_() {}
+
+template <typename K, typename V, typename C, typename A>
+BTree<K, V, C, A>::BTree(const C &comp, const A &alloc)
+    : root_(nullptr),
+      head_(nullptr),
+      tail_(nullptr),
+      size_(0),
+      alloc_(alloc),
+      comp_(comp) {}
+
+template <typename K, typename V, typename C, typename A>
+BTree<K, V, C, A>::BTree(const std::initializer_list<value_type> &items)
+    : BTree(items.begin(), items.end()) {}
+
+template <typename K, typename V, typename C, typename A>
+template <typename InputIt, typename>
+BTree<K, V, C, A>::BTree(InputIt first, InputIt last) : BTree() {
+  std::vector<value_type> values(first, last);
+  std::vector<const value_type *> items;
+  items.reserve(values.size());
+  for (const value_type &value : values) items.push_back(&value);
+  // Sorted once and bulk loaded; stable order keeps the first of equal keys.
+  std::stable_sort(items.begin(), items.end(),
+                   [this](const value_type *a, const value_type *b) {
+                     return comp_(Key_(*a), Key_(*b));
+                   });
+  items.erase(std::unique(items.begin(), items.end(),
+                          [this](const value_type *a, const value_type *b) {
+                            return !comp_(Key_(*a), Key_(*b));
+                          }),
+              items.end());
+  Build_(items);
+}
+
+template <typename K, typename V, typename C, typename A>
+BTree<K, V, C, A>::BTree(const BTree &other)
+    : root_(nullptr),
+      head_(nullptr),
+      tail_(nullptr),
+      size_(0),
+      alloc_(std::allocator_traits<A>::select_on_container_copy_construction(
+          other.alloc_)),
+      comp_(other.comp_) {
+  *this = other;
+}
+
+template <typename K, typename V, typename C, typename A>
+BTree<K, V, C, A>::BTree(BTree &&other) noexcept
+    : root_(nullptr),
+      head_(nullptr),
+      tail_(nullptr),
+      size_(0),
+      alloc_(other.alloc_),
+      comp_(other.comp_) {
+  swap(other);
+}
+
+template <typename K, typename V, typename C, typename A>
+BTree<K, V, C, A>::~BTree() {
+  clear();
+}
+
+template <typename K, typename V, typename C, typename A>
+BTree<K, V, C, A> &BTree<K, V, C, A>::operator=(const BTree &other) {
+  if (this != &other) {
+    clear();
+    comp_ = other.comp_;
+    std::vector<const value_type *> items;
+    items.reserve(other.size_);
+    for (ConstIterator it = other.begin(); it != other.end(); ++it)
+      items.push_back(&*it);
+    Build_(items);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename C, typename A>
+BTree<K, V, C, A> &BTree<K, V, C, A>::operator=(BTree &&other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename C, typename A>
+bool BTree<K, V, C, A>::empty() const noexcept {
+  return !size_;
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::size_type BTree<K, V, C, A>::size() const noexcept {
+  return size_;
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::size_type BTree<K, V, C, A>::max_size()
+    const noexcept {
+  return std::numeric_limits<difference_type>::max() / sizeof(value_type);
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::clear() noexcept {
+  if (root_) Destroy_(root_);
+  root_ = nullptr;
+  head_ = tail_ = nullptr;
+  size_ = 0;
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::Destroy_(Node_ *node) noexcept {
+  if (node->leaf_) {
+    LeafNode_ *leaf = static_cast<LeafNode_ *>(node);
+    for (size_type i = 0; i < leaf->count_; ++i)
+      leaf->Values()[i].~value_type();
+    DeleteNode_(leaf);
+  } else {
+    InnerNode_ *inner = static_cast<InnerNode_ *>(node);
+    for (size_type i = 0; i < inner->count_; ++i) inner->Keys()[i].~K();
+    for (size_type i = 0; i <= inner->count_; ++i)
+      Destroy_(inner->children_[i]);
+    DeleteNode_(inner);
+  }
+}
+
+template <typename K, typename V, typename C, typename A>
+template <typename Node>
+Node *BTree<K, V, C, A>::NewNode_() {
+  typename NodeTraits_<Node>::allocator_type alloc(alloc_);
+  Node *node = NodeTraits_<Node>::allocate(alloc, 1);
+  NodeTraits_<Node>::construct(alloc, node);
+  return node;
+}
+
+template <typename K, typename V, typename C, typename A>
+template <typename Node>
+void BTree<K, V, C, A>::DeleteNode_(Node *node) noexcept {
+  typename NodeTraits_<Node>::allocator_type alloc(alloc_);
+  NodeTraits_<Node>::destroy(alloc, node);
+  NodeTraits_<Node>::deallocate(alloc, node, 1);
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::swap(BTree &other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(head_, other.head_);
+  std::swap(tail_, other.tail_);
+  std::swap(size_, other.size_);
+  std::swap(alloc_, other.alloc_);
+  std::swap(comp_, other.comp_);
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::merge(BTree &other) {
+  if (this == &other) return;
+  for (ConstIterator it = other.begin(); it != other.end(); ++it)
+    Insert_(Key_(*it), *it);
+  other.clear();
+}
+
+template <typename K, typename V, typename C, typename A>
+bool BTree<K, V, C, A>::contains(const K &key) const {
+  return Find_(key) != end();
+}
+
+template <typename K, typename V, typename C, typename A>
+template <typename T>
+void BTree<K, V, C, A>::MoveSlot_(T *from, T *to) {
+  new (to) T(std::move(*from));
+  from->~T();
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::size_type BTree<K, V, C, A>::LeafLowerBound_(
+    LeafNode_ *leaf, const K &key) const {
+  value_type *values = leaf->Values();
+  return std::lower_bound(values, values + leaf->count_, key,
+                          [this](const value_type &value, const K &k) {
+                            return comp_(Key_(value), k);
+                          }) -
+         values;
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::size_type BTree<K, V, C, A>::ChildIndex_(
+    InnerNode_ *parent, Node_ *child) noexcept {
+  size_type index = 0;
+  while (parent->children_[index] != child) ++index;
+  return index;
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::LeafNode_ *BTree<K, V, C, A>::FindLeaf_(
+    const K &key) const {
+  // Separator i is the smallest key under child i + 1, so the descent
+  // follows the first separator greater than key.
+  Node_ *node = root_;
+  while (!node->leaf_) {
+    InnerNode_ *inner = static_cast<InnerNode_ *>(node);
+    K *keys = inner->Keys();
+    K *next = std::upper_bound(
+        keys, keys + inner->count_, key,
+        [this](const K &k, const K &sep) { return comp_(k, sep); });
+    node = inner->children_[next - keys];
+  }
+  return static_cast<LeafNode_ *>(node);
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::Iterator BTree<K, V, C, A>::Find_(
+    const K &key) const {
+  Iterator it = LowerBound_(key);
+  if (it == end() || comp_(key, Key_(*it))) return end();
+  return it;
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::Iterator BTree<K, V, C, A>::LowerBound_(
+    const K &key) const {
+  if (!root_) return end();
+  LeafNode_ *leaf = FindLeaf_(key);
+  size_type index = LeafLowerBound_(leaf, key);
+  if (index == leaf->count_ && leaf->next_) return Iterator(leaf->next_, 0);
+  return Iterator(leaf, index);
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::Iterator BTree<K, V, C, A>::UpperBound_(
+    const K &key) const {
+  Iterator it = LowerBound_(key);
+  if (it != end() && !comp_(key, Key_(*it))) ++it;
+  return it;
+}
+
+// Finds the slot of key and builds the element there from args. key may
+// refer into args, as it is not read once the element is built.
+template <typename K, typename V, typename C, typename A>
+template <typename... Args>
+std::pair<typename BTree<K, V, C, A>::Iterator, bool>
+BTree<K, V, C, A>::Insert_(const K &key, Args &&...args) {
+  if (!root_) root_ = head_ = tail_ = NewNode_<LeafNode_>();
+  LeafNode_ *leaf = FindLeaf_(key);
+  size_type index = LeafLowerBound_(leaf, key);
+  if (index < leaf->count_ && !comp_(key, Key_(leaf->Values()[index])))
+    return {Iterator(leaf, index), false};
+  if (leaf->count_ == kLeafSlots) {
+    LeafNode_ *right = SplitLeaf_(leaf);
+    if (index > leaf->count_) {
+      index -= leaf->count_;
+      leaf = right;
+    }
+  }
+  value_type *values = leaf->Values();
+  for (size_type i = leaf->count_; i > index; --i)
+    MoveSlot_(values + i - 1, values + i);
+  try {
+    new (values + index) value_type(std::forward<Args>(args)...);
+  } catch (...) {
+    for (size_type i = index; i < leaf->count_; ++i)
+      MoveSlot_(values + i + 1, values + i);
+    throw;
+  }
+  ++leaf->count_;
+  ++size_;
+  return {Iterator(leaf, index), true};
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::LeafNode_ *BTree<K, V, C, A>::SplitLeaf_(
+    LeafNode_ *leaf) {
+  LeafNode_ *right = NewNode_<LeafNode_>();
+  size_type keep = leaf->count_ / 2;
+  for (size_type i = keep; i < leaf->count_; ++i)
+    MoveSlot_(leaf->Values() + i, right->Values() + i - keep);
+  right->count_ = leaf->count_ - keep;
+  leaf->count_ = keep;
+  right->prev_ = leaf;
+  right->next_ = leaf->next_;
+  if (leaf->next_)
+    leaf->next_->prev_ = right;
+  else
+    tail_ = right;
+  leaf->next_ = right;
+  InsertIntoParent_(leaf, Key_(right->Values()[0]), right);
+  return right;
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::InsertIntoParent_(Node_ *left, const K &key,
+                                          Node_ *right) {
+  InnerNode_ *parent = left->parent_;
+  if (!parent) {
+    InnerNode_ *root = NewNode_<InnerNode_>();
+    new (root->Keys()) K(key);
+    root->children_[0] = left;
+    root->children_[1] = right;
+    root->count_ = 1;
+    left->parent_ = right->parent_ = root;
+    root_ = root;
+    return;
+  }
+  K *keys = parent->Keys();
+  size_type index = ChildIndex_(parent, left);
+  for (size_type i = parent->count_; i > index; --i) {
+    MoveSlot_(keys + i - 1, keys + i);
+    parent->children_[i + 1] = parent->children_[i];
+  }
+  new (keys + index) K(key);
+  parent->children_[index + 1] = right;
+  right->parent_ = parent;
+  if (++parent->count_ <= kInnerSlots) return;
+
+  // Overfull: the middle key moves up and the keys after it go to a new
+  // sibling together with their children.
+  InnerNode_ *sibling = NewNode_<InnerNode_>();
+  size_type middle = parent->count_ / 2;
+  for (size_type i = middle + 1; i < parent->count_; ++i)
+    MoveSlot_(keys + i, sibling->Keys() + i - middle - 1);
+  for (size_type i = middle + 1; i <= parent->count_; ++i) {
+    sibling->children_[i - middle - 1] = parent->children_[i];
+    parent->children_[i]->parent_ = sibling;
+  }
+  sibling->count_ = parent->count_ - middle - 1;
+  parent->count_ = middle;
+  K up(std::move(keys[middle]));
+  keys[middle].~K();
+  InsertIntoParent_(parent, up, sibling);
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::erase(iterator pos) {
+  LeafNode_ *leaf = pos.GetLeaf();
+  if (!leaf || pos.GetIndex() >= leaf->count_) return;
+  value_type *values = leaf->Values();
+  values[pos.GetIndex()].~value_type();
+  for (size_type i = pos.GetIndex() + 1; i < leaf->count_; ++i)
+    MoveSlot_(values + i, values + i - 1);
+  --leaf->count_;
+  --size_;
+  FixLeaf_(leaf);
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::FixLeaf_(LeafNode_ *leaf) {
+  if (leaf == root_) {
+    if (!leaf->count_) {
+      DeleteNode_(leaf);
+      root_ = head_ = tail_ = nullptr;
+    }
+    return;
+  }
+  if (leaf->count_ >= kMinLeaf) return;
+  InnerNode_ *parent = leaf->parent_;
+  size_type index = ChildIndex_(parent, leaf);
+  LeafNode_ *left =
+      index ? static_cast<LeafNode_ *>(parent->children_[index - 1])
+            : nullptr;
+  LeafNode_ *right =
+      index < parent->count_
+          ? static_cast<LeafNode_ *>(parent->children_[index + 1])
+          : nullptr;
+  if (left && left->count_ > kMinLeaf) {
+    value_type *values = leaf->Values();
+    for (size_type i = leaf->count_; i > 0; --i)
+      MoveSlot_(values + i - 1, values + i);
+    MoveSlot_(left->Values() + --left->count_, values);
+    ++leaf->count_;
+    parent->Keys()[index - 1] = Key_(values[0]);
+  } else if (right && right->count_ > kMinLeaf) {
+    value_type *values = right->Values();
+    MoveSlot_(values, leaf->Values() + leaf->count_++);
+    for (size_type i = 1; i < right->count_; ++i)
+      MoveSlot_(values + i, values + i - 1);
+    --right->count_;
+    parent->Keys()[index] = Key_(values[0]);
+  } else {
+    if (left)
+      MergeLeaves_(left, leaf);
+    else
+      MergeLeaves_(leaf, right);
+    EraseSlot_(parent, left ? index - 1 : index);
+    FixInner_(parent);
+  }
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::MergeLeaves_(LeafNode_ *left, LeafNode_ *right) {
+  for (size_type i = 0; i < right->count_; ++i)
+    MoveSlot_(right->Values() + i, left->Values() + left->count_ + i);
+  left->count_ += right->count_;
+  left->next_ = right->next_;
+  if (right->next_)
+    right->next_->prev_ = left;
+  else
+    tail_ = left;
+  DeleteNode_(right);
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::EraseSlot_(InnerNode_ *node, size_type key_index) {
+  // Drops key key_index together with the child to its right.
+  K *keys = node->Keys();
+  keys[key_index].~K();
+  for (size_type i = key_index + 1; i < node->count_; ++i) {
+    MoveSlot_(keys + i, keys + i - 1);
+    node->children_[i] = node->children_[i + 1];
+  }
+  --node->count_;
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::FixInner_(InnerNode_ *node) {
+  while (node != root_ && node->count_ < kMinInner) {
+    InnerNode_ *parent = node->parent_;
+    size_type index = ChildIndex_(parent, node);
+    InnerNode_ *left =
+        index ? static_cast<InnerNode_ *>(parent->children_[index - 1])
+              : nullptr;
+    InnerNode_ *right =
+        index < parent->count_
+            ? static_cast<InnerNode_ *>(parent->children_[index + 1])
+            : nullptr;
+    K *keys = node->Keys();
+    if (left && left->count_ > kMinInner) {
+      // The separator comes down in front and left's last key goes up.
+      for (size_type i = node->count_; i > 0; --i) {
+        MoveSlot_(keys + i - 1, keys + i);
+        node->children_[i + 1] = node->children_[i];
+      }
+      node->children_[1] = node->children_[0];
+      new (keys) K(std::move(parent->Keys()[index - 1]));
+      node->children_[0] = left->children_[left->count_];
+      node->children_[0]->parent_ = node;
+      ++node->count_;
+      parent->Keys()[index - 1] = std::move(left->Keys()[--left->count_]);
+      left->Keys()[left->count_].~K();
+      return;
+    }
+    if (right && right->count_ > kMinInner) {
+      new (keys + node->count_) K(std::move(parent->Keys()[index]));
+      node->children_[++node->count_] = right->children_[0];
+      right->children_[0]->parent_ = node;
+      K *right_keys = right->Keys();
+      parent->Keys()[index] = std::move(right_keys[0]);
+      right_keys[0].~K();
+      right->children_[0] = right->children_[1];
+      for (size_type i = 1; i < right->count_; ++i) {
+        MoveSlot_(right_keys + i, right_keys + i - 1);
+        right->children_[i] = right->children_[i + 1];
+      }
+      --right->count_;
+      return;
+    }
+    if (left) {
+      MergeInner_(left, node);
+      EraseSlot_(parent, index - 1);
+    } else {
+      MergeInner_(node, right);
+      EraseSlot_(parent, index);
+    }
+    node = parent;
+  }
+  if (node == root_ && !node->count_) {
+    root_ = node->children_[0];
+    root_->parent_ = nullptr;
+    DeleteNode_(node);
+  }
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::MergeInner_(InnerNode_ *left, InnerNode_ *right) {
+  // The separator between the two is copied down; EraseSlot_ drops the
+  // parent's copy along with the pointer to right.
+  InnerNode_ *parent = left->parent_;
+  size_type index = ChildIndex_(parent, left);
+  K *keys = left->Keys();
+  new (keys + left->count_) K(parent->Keys()[index]);
+  for (size_type i = 0; i < right->count_; ++i)
+    MoveSlot_(right->Keys() + i, keys + left->count_ + 1 + i);
+  for (size_type i = 0; i <= right->count_; ++i) {
+    left->children_[left->count_ + 1 + i] = right->children_[i];
+    right->children_[i]->parent_ = left;
+  }
+  left->count_ += right->count_ + 1;
+  DeleteNode_(right);
+}
+
+template <typename K, typename V, typename C, typename A>
+void BTree<K, V, C, A>::Build_(const std::vector<const value_type *> &items) {
+  // Bulk load from sorted unique elements: leaves are filled evenly, which
+  // keeps each of them at least half full, and every inner level is built
+  // the same way over the level below.
+  if (items.empty()) return;
+  size_type leaves = (items.size() + kLeafSlots - 1) / kLeafSlots;
+  std::vector<Node_ *> level;
+  std::vector<const K *> low_keys;
+  LeafNode_ *prev = nullptr;
+  for (size_type i = 0, next = 0; i < leaves; ++i) {
+    LeafNode_ *leaf = NewNode_<LeafNode_>();
+    size_type count = items.size() / leaves + (i < items.size() % leaves);
+    for (; leaf->count_ < count; ++leaf->count_, ++next)
+      new (leaf->Values() + leaf->count_) value_type(*items[next]);
+    leaf->prev_ = prev;
+    if (prev)
+      prev->next_ = leaf;
+    else
+      head_ = leaf;
+    prev = leaf;
+    level.push_back(leaf);
+    low_keys.push_back(&Key_(leaf->Values()[0]));
+  }
+  tail_ = prev;
+  while (level.size() > 1) {
+    size_type parents = (level.size() + kInnerSlots) / (kInnerSlots + 1);
+    std::vector<Node_ *> upper;
+    std::vector<const K *> upper_keys;
+    for (size_type i = 0, next = 0; i < parents; ++i) {
+      InnerNode_ *inner = NewNode_<InnerNode_>();
+      size_type count = level.size() / parents + (i < level.size() % parents);
+      upper_keys.push_back(low_keys[next]);
+      for (size_type j = 0; j < count; ++j, ++next) {
+        if (j) new (inner->Keys() + j - 1) K(*low_keys[next]);
+        inner->children_[j] = level[next];
+        level[next]->parent_ = inner;
+      }
+      inner->count_ = count - 1;
+      upper.push_back(inner);
+    }
+    level.swap(upper);
+    low_keys.swap(upper_keys);
+  }
+  root_ = level[0];
+  size_ = items.size();
+}
+
+template <typename K, typename V, typename C, typename A>
+std::pair<typename BTree<K, V, C, A>::iterator, bool> BTree<K, V, C, A>::insert(
+    const value_type &value) {
+  return Insert_(Key_(value), value);
+}
+
+template <typename K, typename V, typename C, typename A>
+std::pair<typename BTree<K, V, C, A>::iterator, bool> BTree<K, V, C, A>::insert(
+    value_type &&value) {
+  return Insert_(Key_(value), std::move(value));
+}
+
+// A slot is found by key, so the element is built once here and moved into
+// its slot.
+template <typename K, typename V, typename C, typename A>
+template <typename... Args>
+std::pair<typename BTree<K, V, C, A>::iterator, bool>
+BTree<K, V, C, A>::emplace(Args &&...args) {
+  value_type elem(std::forward<Args>(args)...);
+  return Insert_(Key_(elem), std::move(elem));
+}
+
+template <typename K, typename V, typename C, typename A>
+template <typename... Args>
+std::vector<std::pair<typename BTree<K, V, C, A>::iterator, bool>>
+BTree<K, V, C, A>::insert_many(Args &&...args) {
+  std::vector<std::pair<iterator, bool>> res_vec;
+  res_vec.reserve(sizeof...(args));
+  (res_vec.push_back(insert(std::forward<Args>(args))), ...);
+  return res_vec;
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::iterator BTree<K, V, C, A>::find(
+    const K &key) const {
+  return Find_(key);
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::iterator BTree<K, V, C, A>::lower_bound(
+    const K &key) const {
+  return LowerBound_(key);
+}
+
+template <typename K, typename V, typename C, typename A>
+typename BTree<K, V, C, A>::iterator BTree<K, V, C, A>::upper_bound(
+    const K &key) const {
+  return UpperBound_(key);
+}
+
+template <typename K, typename V, typename C, typename A>
+std::pair<typename BTree<K, V, C, A>::iterator,
+          typename BTree<K, V, C, A>::iterator>
+BTree<K, V, C, A>::equal_range(const K &key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+}  // namespace s21
+
+#endif  // S21_BTREE_H_
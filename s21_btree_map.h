@@ -0,0 +1,88 @@
+#ifndef S21_BTREE_MAP_H_
+#define S21_BTREE_MAP_H_
+
+#include "s21_btree.h"
+
+namespace s21 {
+template <typename K, typename V, typename Compare = std::less<>,
+          typename Allocator = std::allocator<std::pair<const K, V>>>
+class btree_map : public BTree<K, V, Compare, Allocator> {
+  using BTree_ = BTree<K, V, Compare, Allocator>;
+
+ public:
+  using typename BTree_::value_type;
+  using typename BTree_::size_type;
+  using typename BTree_::iterator;
+
+  // CONSTRUCTORS
+  btree_map() : BTree_() {}
+  explicit btree_map(const Allocator& alloc) : BTree_(alloc) {}
+  explicit btree_map(const Compare& comp, const Allocator& alloc = Allocator())
+      : BTree_(comp, alloc) {}
+  btree_map(std::initializer_list<value_type> const& items) : BTree_(items) {}
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  btree_map(InputIt first, InputIt last) : BTree_(first, last) {}
+  btree_map(const btree_map& m) : BTree_(m) {}
+  btree_map(btree_map&& m) noexcept : BTree_(std::move(m)) {}
+
+  // DESTRUCTOR
+  ~btree_map() = default;
+
+  // OVERLOAD OPERATORS
+  btree_map& operator=(const btree_map& m) {
+    BTree_::operator=(m);
+    return *this;
+  }
+  btree_map& operator=(btree_map&& m) noexcept {
+    BTree_::operator=(std::move(m));
+    return *this;
+  }
+
+  V& operator[](const K& key) { return try_emplace(key).first->second; }
+
+  // BASIC METHODS
+  using BTree_::erase;
+  using BTree_::insert;
+
+  V& at(const K& key) { return AtOrThrow_(key)->second; }
+  const V& at(const K& key) const { return AtOrThrow_(key)->second; }
+  size_type count(const K& key) const { return this->contains(key) ? 1 : 0; }
+  size_type erase(const K& key) {
+    iterator it = this->Find_(key);
+    if (it == this->end()) return 0;
+    BTree_::erase(it);
+    return 1;
+  }
+  std::pair<iterator, bool> insert(const K& key, const V& obj) {
+    return try_emplace(key, obj);
+  }
+  std::pair<iterator, bool> insert_or_assign(const K& key, const V& obj) {
+    std::pair<iterator, bool> res_it = insert(key, obj);
+    if (!res_it.second) res_it.first->second = obj;
+    return res_it;
+  }
+  // The pair is built in its slot, and only when key is new.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+    return this->Insert_(key, std::piecewise_construct,
+                         std::forward_as_tuple(key),
+                         std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    return this->Insert_(key, std::piecewise_construct,
+                         std::forward_as_tuple(std::move(key)),
+                         std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+ private:
+  iterator AtOrThrow_(const K& key) const {
+    iterator it = this->Find_(key);
+    if (it == this->end()) throw std::out_of_range("Key does not exist");
+    return it;
+  }
+};
+}  // namespace s21
+
+#endif  // S21_BTREE_MAP_H_
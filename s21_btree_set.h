@@ -0,0 +1,83 @@
+#ifndef S21_BTREE_SET_H_
+#define S21_BTREE_SET_H_
+
+#include "s21_btree.h"
+
+namespace s21 {
+template <typename K, typename Compare = std::less<>,
+          typename Allocator = std::allocator<K>>
+class btree_set : public BTree<K, KeyOnly, Compare, Allocator> {
+  using BTree_ = BTree<K, KeyOnly, Compare, Allocator>;
+
+ public:
+  using key_type = K;
+  using value_type = K;
+  using reference = K &;
+  using const_reference = const K &;
+  using size_type = size_t;
+
+  // Keys are immutable through set iterators, so both aliases are const.
+  using iterator = typename BTree_::ConstIterator;
+  using const_iterator = iterator;
+
+  btree_set() : BTree_() {}
+  explicit btree_set(const Allocator &alloc) : BTree_(alloc) {}
+  explicit btree_set(const Compare &comp, const Allocator &alloc = Allocator())
+      : BTree_(comp, alloc) {}
+  btree_set(std::initializer_list<value_type> const &items) : BTree_(items) {}
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  btree_set(InputIt first, InputIt last) : BTree_(first, last) {}
+  btree_set(const btree_set &s) : BTree_(s) {}
+  btree_set(btree_set &&s) noexcept : BTree_(std::move(s)) {}
+  ~btree_set() = default;
+
+  btree_set &operator=(const btree_set &s) {
+    BTree_::operator=(s);
+    return *this;
+  }
+  btree_set &operator=(btree_set &&s) noexcept {
+    BTree_::operator=(std::move(s));
+    return *this;
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return BTree_::insert(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return BTree_::insert(std::move(value));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return BTree_::emplace(std::forward<Args>(args)...);
+  }
+
+  iterator begin() const { return BTree_::begin(); }
+  iterator end() const { return BTree_::end(); }
+  iterator find(const K &key) const { return BTree_::find(key); }
+  iterator lower_bound(const K &key) const { return BTree_::lower_bound(key); }
+  iterator upper_bound(const K &key) const { return BTree_::upper_bound(key); }
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return BTree_::equal_range(key);
+  }
+  void erase(iterator pos) {
+    BTree_::erase(typename BTree_::Iterator(pos.GetLeaf(), pos.GetIndex()));
+  }
+  size_type erase(const K &key) {
+    iterator it = find(key);
+    if (it == end()) return 0;
+    erase(it);
+    return 1;
+  }
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    std::vector<std::pair<iterator, bool>> res_set_vec;
+    res_set_vec.reserve(sizeof...(args));
+    (res_set_vec.push_back(btree_set::insert(std::forward<Args>(args))), ...);
+    return res_set_vec;
+  }
+};
+}  // namespace s21
+
+#endif  // S21_BTREE_SET_H_
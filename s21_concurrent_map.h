@@ -0,0 +1,329 @@
+#ifndef S21_CONCURRENT_MAP_H_
+#define S21_CONCURRENT_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include "s21_map.h"
+
+namespace s21 {
+// Ordered map for use from many threads at once. Keys are spread by hash
+// over a fixed number of shards, each an s21::map behind a reader-writer
+// lock of its own: lookups run in parallel everywhere, and updates run in
+// parallel as long as their keys land in different shards. An operation on
+// one key locks one shard.
+//
+// No iterator or reference into a shard is handed out, since it would
+// outlive the lock. find copies the value out, and visit runs a callback on
+// the value while its shard stays locked. size() and for_each_shard lock
+// the shards one after another, so each shard is seen consistent but the
+// map as a whole may change between them. for_each_ordered and snapshot
+// hold every shard for the whole scan and see one state of the map, in key
+// order.
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename Compare = std::less<>,
+          typename Allocator = std::allocator<std::pair<const K, V>>>
+class concurrent_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<const K, V>;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using shard_type = map<K, V, Compare, Allocator>;
+
+  static constexpr size_type kDefaultShards = 64;
+
+  // CONSTRUCTORS
+  // The shard count is fixed for the lifetime of the map; 0 means 1. Every
+  // shard gets its own copy of comp and alloc, and shards are written from
+  // many threads at once, so copies of alloc that share a pool, as those of
+  // node_pool_allocator do, are only safe if the pool is synchronised.
+  explicit concurrent_map(size_type shard_count = kDefaultShards,
+                          const Hash &hash = Hash(),
+                          const Compare &comp = Compare(),
+                          const Allocator &alloc = Allocator());
+  explicit concurrent_map(const Allocator &alloc);
+  explicit concurrent_map(const Compare &comp,
+                          const Allocator &alloc = Allocator());
+  concurrent_map(std::initializer_list<value_type> const &items);
+  concurrent_map(const concurrent_map &other) = delete;
+
+  // DESTRUCTOR
+  ~concurrent_map() = default;
+
+  // OVERLOAD OPERATORS
+  concurrent_map &operator=(const concurrent_map &other) = delete;
+
+  // BASIC METHODS
+  size_type shard_count() const noexcept { return shard_count_; }
+  allocator_type get_allocator() const {
+    return shards_[0].map_.get_allocator();
+  }
+  key_compare key_comp() const { return shards_[0].map_.key_comp(); }
+  size_type size() const;
+  bool empty() const;
+  void clear();
+  hasher hash_function() const { return hash_; }
+
+  // LOOKUP
+  // find returns a copy of the value, or nothing for a missing key. visit
+  // calls f with the value of key under the shard's lock, exclusive for the
+  // non-const overload, and returns whether the key was there. f must not
+  // call back into the map.
+  std::optional<V> find(const K &key) const;
+  bool contains(const K &key) const;
+  template <typename F>
+  bool visit(const K &key, F &&f);
+  template <typename F>
+  bool visit(const K &key, F &&f) const;
+
+  // MODIFIERS
+  // Each returns whether a new element went in.
+  bool insert(const value_type &value);
+  bool insert(value_type &&value);
+  bool insert(const K &key, const V &obj);
+  bool insert_or_assign(const K &key, const V &obj);
+  template <typename... Args>
+  bool try_emplace(const K &key, Args &&...args);
+  size_type erase(const K &key);
+
+  // SCANS
+  // for_each_shard calls f with each shard in turn while holding its lock,
+  // exclusive for the non-const overload. for_each_ordered calls f with
+  // every element in key order; it merges the shards under their shared
+  // locks, so writers wait until it returns.
+  template <typename F>
+  void for_each_shard(F &&f);
+  template <typename F>
+  void for_each_shard(F &&f) const;
+  template <typename F>
+  void for_each_ordered(F &&f) const;
+  shard_type snapshot() const;
+
+ private:
+  // One shard per cache line, so a writer taking one lock does not slow
+  // down readers of the neighbouring shard.
+  struct alignas(64) Shard_ {
+    mutable std::shared_mutex mutex_;
+    shard_type map_;
+  };
+
+  Shard_ &ShardFor_(const K &key) const;
+
+  Hash hash_;
+  size_type shard_count_;
+  std::unique_ptr<Shard_[]> shards_;
+};
+
+template <typename K, typename V, typename H, typename C, typename A>
+concurrent_map<K, V, H, C, A>::concurrent_map(size_type shard_count,
+                                              const H &hash, const C &comp,
+                                              const A &alloc)
+    : hash_(hash),
+      shard_count_(shard_count ? shard_count : 1),
+      shards_(new Shard_[shard_count_]) {
+  for (size_type i = 0; i < shard_count_; ++i)
+    shards_[i].map_ = shard_type(comp, alloc);
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+concurrent_map<K, V, H, C, A>::concurrent_map(const A &alloc)
+    : concurrent_map(kDefaultShards, H(), C(), alloc) {}
+
+template <typename K, typename V, typename H, typename C, typename A>
+concurrent_map<K, V, H, C, A>::concurrent_map(const C &comp, const A &alloc)
+    : concurrent_map(kDefaultShards, H(), comp, alloc) {}
+
+template <typename K, typename V, typename H, typename C, typename A>
+concurrent_map<K, V, H, C, A>::concurrent_map(
+    std::initializer_list<value_type> const &items)
+    : concurrent_map() {
+  for (const value_type &item : items) insert(item);
+}
+
+// Standard hashes of integers are often the identity, so the hash is
+// scrambled with a Fibonacci multiply before it picks a shard, as in
+// HashTable.
+template <typename K, typename V, typename H, typename C, typename A>
+typename concurrent_map<K, V, H, C, A>::Shard_ &
+concurrent_map<K, V, H, C, A>::ShardFor_(const K &key) const {
+  std::uint64_t hash =
+      static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+  return shards_[static_cast<size_type>(hash >> 32) % shard_count_];
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+typename concurrent_map<K, V, H, C, A>::size_type
+concurrent_map<K, V, H, C, A>::size() const {
+  size_type total = 0;
+  for_each_shard([&total](const shard_type &shard) { total += shard.size(); });
+  return total;
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+bool concurrent_map<K, V, H, C, A>::empty() const {
+  return size() == 0;
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+void concurrent_map<K, V, H, C, A>::clear() {
+  for_each_shard([](shard_type &shard) { shard.clear(); });
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+std::optional<V> concurrent_map<K, V, H, C, A>::find(const K &key) const {
+  std::optional<V> res;
+  visit(key, [&res](const V &value) { res.emplace(value); });
+  return res;
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+bool concurrent_map<K, V, H, C, A>::contains(const K &key) const {
+  Shard_ &shard = ShardFor_(key);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+  return shard.map_.contains(key);
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+template <typename F>
+bool concurrent_map<K, V, H, C, A>::visit(const K &key, F &&f) {
+  Shard_ &shard = ShardFor_(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+  auto it = shard.map_.find(key);
+  if (it == shard.map_.end()) return false;
+  std::forward<F>(f)(it->second);
+  return true;
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+template <typename F>
+bool concurrent_map<K, V, H, C, A>::visit(const K &key, F &&f) const {
+  Shard_ &shard = ShardFor_(key);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+  auto it = shard.map_.find(key);
+  if (it == shard.map_.end()) return false;
+  std::forward<F>(f)(static_cast<const V &>(it->second));
+  return true;
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+bool concurrent_map<K, V, H, C, A>::insert(const value_type &value) {
+  Shard_ &shard = ShardFor_(value.first);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+  return shard.map_.insert(value).second;
+}
+
+// The shard is chosen before value is moved into it.
+template <typename K, typename V, typename H, typename C, typename A>
+bool concurrent_map<K, V, H, C, A>::insert(value_type &&value) {
+  Shard_ &shard = ShardFor_(value.first);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+  return shard.map_.insert(std::move(value)).second;
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+bool concurrent_map<K, V, H, C, A>::insert(const K &key, const V &obj) {
+  return try_emplace(key, obj);
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+bool concurrent_map<K, V, H, C, A>::insert_or_assign(const K &key,
+                                                     const V &obj) {
+  Shard_ &shard = ShardFor_(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+  return shard.map_.insert_or_assign(key, obj).second;
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+template <typename... Args>
+bool concurrent_map<K, V, H, C, A>::try_emplace(const K &key,
+                                                Args &&...args) {
+  Shard_ &shard = ShardFor_(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+  return shard.map_.try_emplace(key, std::forward<Args>(args)...).second;
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+typename concurrent_map<K, V, H, C, A>::size_type
+concurrent_map<K, V, H, C, A>::erase(const K &key) {
+  Shard_ &shard = ShardFor_(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+  return shard.map_.erase(key);
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+template <typename F>
+void concurrent_map<K, V, H, C, A>::for_each_shard(F &&f) {
+  for (size_type i = 0; i < shard_count_; ++i) {
+    std::unique_lock<std::shared_mutex> lock(shards_[i].mutex_);
+    f(shards_[i].map_);
+  }
+}
+
+template <typename K, typename V, typename H, typename C, typename A>
+template <typename F>
+void concurrent_map<K, V, H, C, A>::for_each_shard(F &&f) const {
+  for (size_type i = 0; i < shard_count_; ++i) {
+    std::shared_lock<std::shared_mutex> lock(shards_[i].mutex_);
+    f(static_cast<const shard_type &>(shards_[i].map_));
+  }
+}
+
+// Shards are locked in index order. A writer only ever holds one lock, so
+// this cannot deadlock with them. The merge keeps a heap of the next element
+// of each shard and pops the smallest, O(n log s) over s shards.
+template <typename K, typename V, typename H, typename C, typename A>
+template <typename F>
+void concurrent_map<K, V, H, C, A>::for_each_ordered(F &&f) const {
+  using Iter = typename shard_type::const_iterator;
+  std::vector<std::shared_lock<std::shared_mutex>> locks;
+  std::vector<std::pair<Iter, Iter>> heads;
+  locks.reserve(shard_count_);
+  for (size_type i = 0; i < shard_count_; ++i) {
+    locks.emplace_back(shards_[i].mutex_);
+    const shard_type &shard = shards_[i].map_;
+    if (!shard.empty()) heads.emplace_back(shard.begin(), shard.end());
+  }
+  C comp = key_comp();
+  auto later = [&comp](const std::pair<Iter, Iter> &a,
+                       const std::pair<Iter, Iter> &b) {
+    return comp(b.first->first, a.first->first);
+  };
+  std::make_heap(heads.begin(), heads.end(), later);
+  while (!heads.empty()) {
+    std::pop_heap(heads.begin(), heads.end(), later);
+    std::pair<Iter, Iter> &head = heads.back();
+    f(*head.first);
+    if (++head.first == head.second) {
+      heads.pop_back();
+    } else {
+      std::push_heap(heads.begin(), heads.end(), later);
+    }
+  }
+}
+
+// Elements arrive in order, so each one is linked in at the end of the copy
+// through the hinted insert without a descent.
+template <typename K, typename V, typename H, typename C, typename A>
+typename concurrent_map<K, V, H, C, A>::shard_type
+concurrent_map<K, V, H, C, A>::snapshot() const {
+  shard_type res(key_comp(), get_allocator());
+  for_each_ordered(
+      [&res](const value_type &value) { res.insert(res.end(), value); });
+  return res;
+}
+}  // namespace s21
+
+#endif  // S21_CONCURRENT_MAP_H_
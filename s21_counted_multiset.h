@@ -0,0 +1,241 @@
+#ifndef S21_COUNTED_MULTISET_H_
+#define S21_COUNTED_MULTISET_H_
+
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "s21_map.h"
+
+namespace s21 {
+// Multiset that stores each distinct key once, in a tree node next to the
+// number of its copies. A histogram of a few hundred keys holding millions of
+// copies takes a few hundred nodes, and count, equal_range and erase(key)
+// each touch one node, so all three are O(log n) in the number of distinct
+// keys. Iteration still yields every copy: an iterator is a node and the
+// index of a copy within it. Copies share the stored key, so keys that
+// compare equal but differ otherwise keep the first one inserted.
+template <typename K, typename Compare = std::less<>,
+          typename Allocator = std::allocator<K>>
+class counted_multiset {
+  using Map_ =
+      map<K, std::size_t, Compare,
+          typename std::allocator_traits<Allocator>::template rebind_alloc<
+              std::pair<const K, std::size_t>>>;
+
+ public:
+  using key_type = K;
+  using value_type = K;
+  using reference = const K &;
+  using const_reference = const K &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  class ConstIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = K;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const K *;
+    using reference = const K &;
+
+    ConstIterator() = default;
+
+    bool operator==(const ConstIterator &other) const {
+      return node_ == other.node_ && copy_ == other.copy_;
+    }
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    }
+    reference operator*() const { return node_->first; }
+    pointer operator->() const { return &node_->first; }
+    ConstIterator &operator++() {
+      if (node_.GetNode() && ++copy_ == node_->second) {
+        ++node_;
+        copy_ = 0;
+      }
+      return *this;
+    }
+    ConstIterator operator++(int) {
+      ConstIterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+    ConstIterator &operator--() {
+      if (copy_) {
+        --copy_;
+      } else {
+        --node_;
+        if (node_.GetNode()) copy_ = node_->second - 1;
+      }
+      return *this;
+    }
+    ConstIterator operator--(int) {
+      ConstIterator tmp(*this);
+      --*this;
+      return tmp;
+    }
+
+   private:
+    friend class counted_multiset;
+    ConstIterator(typename Map_::iterator node, size_type copy)
+        : node_(node), copy_(copy) {}
+
+    typename Map_::iterator node_;
+    size_type copy_ = 0;
+  };
+
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+  // CONSTRUCTORS
+  counted_multiset() = default;
+  explicit counted_multiset(const Allocator &alloc)
+      : tree_(typename Map_::allocator_type(alloc)) {}
+  explicit counted_multiset(const Compare &comp,
+                            const Allocator &alloc = Allocator())
+      : tree_(comp, typename Map_::allocator_type(alloc)) {}
+  counted_multiset(std::initializer_list<value_type> const &items)
+      : counted_multiset(items.begin(), items.end()) {}
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  counted_multiset(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+  counted_multiset(const counted_multiset &other) = default;
+  counted_multiset(counted_multiset &&other) noexcept
+      : tree_(std::move(other.tree_)), size_(other.size_) {
+    other.size_ = 0;
+  }
+
+  // DESTRUCTOR
+  ~counted_multiset() = default;
+
+  // OVERLOAD OPERATORS
+  counted_multiset &operator=(const counted_multiset &other) = default;
+  counted_multiset &operator=(counted_multiset &&other) noexcept {
+    if (this != &other) {
+      tree_ = std::move(other.tree_);
+      size_ = other.size_;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  // BASIC METHODS
+  // size() counts every copy, distinct() the keys, one node each.
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type distinct() const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max();
+  }
+  allocator_type get_allocator() const {
+    return allocator_type(tree_.get_allocator());
+  }
+  key_compare key_comp() const { return tree_.key_comp(); }
+  void clear() noexcept {
+    tree_.clear();
+    size_ = 0;
+  }
+  void swap(counted_multiset &other) {
+    tree_.swap(other.tree_);
+    std::swap(size_, other.size_);
+  }
+  // Adds the copies of each key of other, one lookup per distinct key.
+  void merge(counted_multiset &other);
+
+  iterator begin() const noexcept { return iterator(tree_.begin(), 0); }
+  iterator end() const noexcept { return iterator(tree_.end(), 0); }
+
+  // Inserting returns the last copy of the key, the one just added.
+  iterator insert(const value_type &value) { return insert(value, 1); }
+  iterator insert(const value_type &value, size_type copies);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first, 1);
+  }
+  // erase(pos) removes one copy; erase(key) removes them all and returns how
+  // many there were.
+  void erase(iterator pos);
+  size_type erase(const K &key);
+
+  // LOOKUP
+  // Lookups take any type comparable with K, as Tree does. find returns the
+  // first copy of the key, or end().
+  template <typename T = K>
+  size_type count(const T &key) const {
+    auto node = tree_.find(key);
+    return node == tree_.end() ? 0 : node->second;
+  }
+  template <typename T = K>
+  bool contains(const T &key) const {
+    return tree_.contains(key);
+  }
+  template <typename T = K>
+  iterator find(const T &key) const {
+    return iterator(tree_.find(key), 0);
+  }
+  template <typename T = K>
+  iterator lower_bound(const T &key) const {
+    return iterator(tree_.lower_bound(key), 0);
+  }
+  template <typename T = K>
+  iterator upper_bound(const T &key) const {
+    return iterator(tree_.upper_bound(key), 0);
+  }
+  template <typename T = K>
+  std::pair<iterator, iterator> equal_range(const T &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+ private:
+  Map_ tree_;
+  size_type size_ = 0;
+};
+
+template <typename K, typename Compare, typename Allocator>
+typename counted_multiset<K, Compare, Allocator>::iterator
+counted_multiset<K, Compare, Allocator>::insert(const value_type &value,
+                                                size_type copies) {
+  if (!copies) return find(value);
+  // The key is copied into a node only when it is new.
+  auto res = tree_.try_emplace(value, 0);
+  res.first->second += copies;
+  size_ += copies;
+  return iterator(res.first, res.first->second - 1);
+}
+
+template <typename K, typename Compare, typename Allocator>
+void counted_multiset<K, Compare, Allocator>::erase(iterator pos) {
+  if (!pos.node_.GetNode()) return;
+  if (--pos.node_->second == 0) tree_.erase(pos.node_);
+  --size_;
+}
+
+template <typename K, typename Compare, typename Allocator>
+typename counted_multiset<K, Compare, Allocator>::size_type
+counted_multiset<K, Compare, Allocator>::erase(const K &key) {
+  auto node = tree_.find(key);
+  if (node == tree_.end()) return 0;
+  size_type copies = node->second;
+  tree_.erase(node);
+  size_ -= copies;
+  return copies;
+}
+
+template <typename K, typename Compare, typename Allocator>
+void counted_multiset<K, Compare, Allocator>::merge(counted_multiset &other) {
+  if (this == &other) return;
+  for (auto node = other.tree_.begin(); node != other.tree_.end(); ++node)
+    insert(node->first, node->second);
+  other.clear();
+}
+}  // namespace s21
+
+#endif  // S21_COUNTED_MULTISET_H_
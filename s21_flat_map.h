@@ -0,0 +1,71 @@
+#ifndef S21_FLAT_MAP_H_
+#define S21_FLAT_MAP_H_
+
+#include <stdexcept>
+
+#include "s21_flat_tree.h"
+
+namespace s21 {
+template <typename K, typename V>
+class flat_map : public FlatTree<K, V> {
+ public:
+  using typename FlatTree<K, V>::value_type;
+  using typename FlatTree<K, V>::size_type;
+  using typename FlatTree<K, V>::iterator;
+  using typename FlatTree<K, V>::const_iterator;
+
+  // CONSTRUCTORS
+  flat_map() : FlatTree<K, V>() {}
+  flat_map(std::initializer_list<value_type> const &items)
+      : FlatTree<K, V>(items) {}
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_map(InputIt first, InputIt last) : FlatTree<K, V>(first, last) {}
+  flat_map(const flat_map &m) : FlatTree<K, V>(m) {}
+  flat_map(flat_map &&m) noexcept : FlatTree<K, V>(std::move(m)) {}
+
+  // DESTRUCTOR
+  ~flat_map() = default;
+
+  // OVERLOAD OPERATORS
+  flat_map &operator=(const flat_map &m) {
+    FlatTree<K, V>::operator=(m);
+    return *this;
+  }
+  flat_map &operator=(flat_map &&m) noexcept {
+    FlatTree<K, V>::operator=(std::move(m));
+    return *this;
+  }
+
+  V &operator[](const K &key) {
+    iterator it = this->find(key);
+    if (it != this->end()) return it->second;
+    return insert(key, V()).first->second;
+  }
+
+  // BASIC METHODS
+  using FlatTree<K, V>::insert;
+
+  V &at(const K &key) {
+    iterator it = this->find(key);
+    if (it == this->end()) throw std::out_of_range("Key does not exist");
+    return it->second;
+  }
+  const V &at(const K &key) const {
+    const_iterator it = this->find(key);
+    if (it == this->end()) throw std::out_of_range("Key does not exist");
+    return it->second;
+  }
+  size_type count(const K &key) const { return this->contains(key) ? 1 : 0; }
+  std::pair<iterator, bool> insert(const K &key, const V &obj) {
+    return insert(value_type(key, obj));
+  }
+  std::pair<iterator, bool> insert_or_assign(const K &key, const V &obj) {
+    std::pair<iterator, bool> res_it = insert(key, obj);
+    if (!res_it.second) res_it.first->second = obj;
+    return res_it;
+  }
+};
+}  // namespace s21
+
+#endif  // S21_FLAT_MAP_H_
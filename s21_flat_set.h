@@ -0,0 +1,69 @@
+#ifndef S21_FLAT_SET_H_
+#define S21_FLAT_SET_H_
+
+#include "s21_flat_tree.h"
+
+namespace s21 {
+template <typename K>
+class flat_set : public FlatTree<K, KeyOnly> {
+ public:
+  using key_type = K;
+  using value_type = K;
+  using reference = K &;
+  using const_reference = const K &;
+  using size_type = size_t;
+
+  // Keys are immutable through set iterators, so both aliases are const.
+  using iterator = const K *;
+  using const_iterator = iterator;
+
+  flat_set() : FlatTree<K, KeyOnly>() {}
+  flat_set(std::initializer_list<value_type> const &items)
+      : FlatTree<K, KeyOnly>(items) {}
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_set(InputIt first, InputIt last) : FlatTree<K, KeyOnly>(first, last) {}
+  flat_set(const flat_set &s) : FlatTree<K, KeyOnly>(s) {}
+  flat_set(flat_set &&s) noexcept : FlatTree<K, KeyOnly>(std::move(s)) {}
+  ~flat_set() = default;
+
+  flat_set &operator=(const flat_set &s) {
+    FlatTree<K, KeyOnly>::operator=(s);
+    return *this;
+  }
+  flat_set &operator=(flat_set &&s) noexcept {
+    FlatTree<K, KeyOnly>::operator=(std::move(s));
+    return *this;
+  }
+
+  using FlatTree<K, KeyOnly>::insert;
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return FlatTree<K, KeyOnly>::insert(value);
+  }
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    auto res_vec =
+        FlatTree<K, KeyOnly>::insert_many(std::forward<Args>(args)...);
+    return std::vector<std::pair<iterator, bool>>(res_vec.begin(),
+                                                  res_vec.end());
+  }
+
+  iterator begin() const noexcept { return FlatTree<K, KeyOnly>::begin(); }
+  iterator end() const noexcept { return FlatTree<K, KeyOnly>::end(); }
+  iterator find(const K &key) const noexcept {
+    return FlatTree<K, KeyOnly>::find(key);
+  }
+  iterator lower_bound(const K &key) const noexcept {
+    return FlatTree<K, KeyOnly>::lower_bound(key);
+  }
+  iterator upper_bound(const K &key) const noexcept {
+    return FlatTree<K, KeyOnly>::upper_bound(key);
+  }
+  std::pair<iterator, iterator> equal_range(const K &key) const noexcept {
+    return FlatTree<K, KeyOnly>::equal_range(key);
+  }
+  size_type count(const K &key) const { return this->contains(key) ? 1 : 0; }
+};
+}  // namespace s21
+
+#endif  // S21_FLAT_SET_H_
@@ -0,0 +1,302 @@
+#ifndef S21_FLAT_TREE_H_
+#define S21_FLAT_TREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "s21_binary_tree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// s21::vector needs assignable elements, so unlike TreeValue the key of a
+// flat map element is not const. Changing it through an iterator breaks the
+// ordering; only the mapped value may be written.
+template <typename K, typename V>
+struct FlatValue {
+  using type = std::pair<K, V>;
+  static const K &Key(const type &value) noexcept { return value.first; }
+};
+
+template <typename K>
+struct FlatValue<K, KeyOnly> {
+  using type = K;
+  static const K &Key(const type &value) noexcept { return value; }
+};
+
+// Sorted array behind flat_map and flat_set. Elements are kept contiguous in
+// key order, so lookups are a binary search over one block of memory and a
+// full scan never chases a pointer. Single insertions and erasures shift the
+// tail of the array and are linear; batches should go through insert_many or
+// the range insert, which sort the batch and merge it in one pass. Any
+// insertion or erasure invalidates iterators.
+template <typename K, typename V>
+class FlatTree {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = typename FlatValue<K, V>::type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = value_type *;
+  using const_iterator = const value_type *;
+  using size_type = size_t;
+
+  // CONSTRUCTORS
+  FlatTree() = default;
+  FlatTree(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  FlatTree(InputIt first, InputIt last);
+  FlatTree(const FlatTree &other) : data_(other.data_) {}
+  FlatTree(FlatTree &&other) noexcept { data_.swap(other.data_); }
+
+  // DESTRUCTOR
+  virtual ~FlatTree() = default;
+
+  // BASIC METHODS
+  bool empty() const noexcept { return data_.empty(); }
+  size_type size() const noexcept { return data_.size(); }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<std::ptrdiff_t>::max() / sizeof(value_type);
+  }
+  void clear() noexcept { data_.clear(); }
+  void swap(FlatTree &other) noexcept { data_.swap(other.data_); }
+  void merge(FlatTree &other);
+  // Drops the spare capacity left by growth, for tables that are built once.
+  void shrink_to_fit() { data_.shrink_to_fit(); }
+  bool contains(const K &key) const noexcept;
+
+  // OVERLOAD OPERATORS
+  FlatTree &operator=(const FlatTree &other);
+  FlatTree &operator=(FlatTree &&other) noexcept;
+
+  iterator begin() noexcept { return data_.begin(); }
+  iterator end() noexcept { return data_.end(); }
+  const_iterator begin() const noexcept { return data_.begin(); }
+  const_iterator end() const noexcept { return data_.end(); }
+
+  std::pair<iterator, bool> insert(const value_type &value);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void insert(InputIt first, InputIt last);
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+  iterator erase(const_iterator pos);
+  size_type erase(const K &key);
+
+  // LOOKUP
+  // find returns end() for a missing key.
+  iterator find(const K &key) noexcept;
+  const_iterator find(const K &key) const noexcept;
+  iterator lower_bound(const K &key) noexcept;
+  const_iterator lower_bound(const K &key) const noexcept;
+  iterator upper_bound(const K &key) noexcept;
+  const_iterator upper_bound(const K &key) const noexcept;
+  std::pair<iterator, iterator> equal_range(const K &key) noexcept;
+  std::pair<const_iterator, const_iterator> equal_range(
+      const K &key) const noexcept;
+
+ protected:
+  vector<value_type> data_;
+
+  static const K &Key_(const value_type &value) noexcept {
+    return FlatValue<K, V>::Key(value);
+  }
+
+  // Index of the first element whose key is not less than key.
+  size_type LowerIndex_(const K &key) const noexcept;
+
+ private:
+  std::vector<std::pair<size_type, bool>> MergeBatch_(
+      std::vector<value_type> &batch);
+};
+
+template <typename K, typename V>
+FlatTree<K, V>::FlatTree(std::initializer_list<value_type> const &items)
+    : FlatTree(items.begin(), items.end()) {}
+
+template <typename K, typename V>
+template <typename InputIt, typename>
+FlatTree<K, V>::FlatTree(InputIt first, InputIt last) {
+  insert(first, last);
+}
+
+template <typename K, typename V>
+FlatTree<K, V> &FlatTree<K, V>::operator=(const FlatTree &other) {
+  if (this != &other) data_ = other.data_;
+  return *this;
+}
+
+template <typename K, typename V>
+FlatTree<K, V> &FlatTree<K, V>::operator=(FlatTree &&other) noexcept {
+  if (this != &other) {
+    data_.clear();
+    data_.swap(other.data_);
+  }
+  return *this;
+}
+
+template <typename K, typename V>
+typename FlatTree<K, V>::size_type FlatTree<K, V>::LowerIndex_(
+    const K &key) const noexcept {
+  const_iterator first = begin();
+  const_iterator it = std::lower_bound(
+      first, end(), key,
+      [](const value_type &value, const K &k) { return Key_(value) < k; });
+  return static_cast<size_type>(it - first);
+}
+
+template <typename K, typename V>
+bool FlatTree<K, V>::contains(const K &key) const noexcept {
+  return find(key) != end();
+}
+
+template <typename K, typename V>
+typename FlatTree<K, V>::iterator FlatTree<K, V>::find(const K &key) noexcept {
+  iterator it = begin() + LowerIndex_(key);
+  return it != end() && !(key < Key_(*it)) ? it : end();
+}
+
+template <typename K, typename V>
+typename FlatTree<K, V>::const_iterator FlatTree<K, V>::find(
+    const K &key) const noexcept {
+  const_iterator it = begin() + LowerIndex_(key);
+  return it != end() && !(key < Key_(*it)) ? it : end();
+}
+
+template <typename K, typename V>
+typename FlatTree<K, V>::iterator FlatTree<K, V>::lower_bound(
+    const K &key) noexcept {
+  return begin() + LowerIndex_(key);
+}
+
+template <typename K, typename V>
+typename FlatTree<K, V>::const_iterator FlatTree<K, V>::lower_bound(
+    const K &key) const noexcept {
+  return begin() + LowerIndex_(key);
+}
+
+template <typename K, typename V>
+typename FlatTree<K, V>::iterator FlatTree<K, V>::upper_bound(
+    const K &key) noexcept {
+  iterator it = lower_bound(key);
+  return it != end() && !(key < Key_(*it)) ? it + 1 : it;
+}
+
+template <typename K, typename V>
+typename FlatTree<K, V>::const_iterator FlatTree<K, V>::upper_bound(
+    const K &key) const noexcept {
+  const_iterator it = lower_bound(key);
+  return it != end() && !(key < Key_(*it)) ? it + 1 : it;
+}
+
+template <typename K, typename V>
+std::pair<typename FlatTree<K, V>::iterator, typename FlatTree<K, V>::iterator>
+FlatTree<K, V>::equal_range(const K &key) noexcept {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename K, typename V>
+std::pair<typename FlatTree<K, V>::const_iterator,
+          typename FlatTree<K, V>::const_iterator>
+FlatTree<K, V>::equal_range(const K &key) const noexcept {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename K, typename V>
+std::pair<typename FlatTree<K, V>::iterator, bool> FlatTree<K, V>::insert(
+    const value_type &value) {
+  iterator it = lower_bound(Key_(value));
+  if (it != end() && !(Key_(value) < Key_(*it))) return {it, false};
+  return {data_.insert(it, value), true};
+}
+
+template <typename K, typename V>
+template <typename InputIt, typename>
+void FlatTree<K, V>::insert(InputIt first, InputIt last) {
+  std::vector<value_type> batch(first, last);
+  MergeBatch_(batch);
+}
+
+// Each result points at the element with the argument's key, whether it was
+// inserted or already present.
+template <typename K, typename V>
+template <typename... Args>
+std::vector<std::pair<typename FlatTree<K, V>::iterator, bool>>
+FlatTree<K, V>::insert_many(Args &&...args) {
+  std::vector<value_type> batch;
+  batch.reserve(sizeof...(args));
+  (batch.emplace_back(std::forward<Args>(args)), ...);
+  std::vector<std::pair<iterator, bool>> res_vec;
+  res_vec.reserve(batch.size());
+  for (const auto &res : MergeBatch_(batch))
+    res_vec.emplace_back(begin() + res.first, res.second);
+  return res_vec;
+}
+
+// Sorts the batch by key and merges it with data_ into a new array in one
+// pass. Existing elements win over the batch, and among equal keys in the
+// batch the first one wins. The elements that go in are moved out of the
+// batch. Returns, for each batch element, the index its key ends up at and
+// whether it went in.
+template <typename K, typename V>
+std::vector<std::pair<typename FlatTree<K, V>::size_type, bool>>
+FlatTree<K, V>::MergeBatch_(std::vector<value_type> &batch) {
+  std::vector<size_type> order(batch.size());
+  for (size_type i = 0; i < order.size(); ++i) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+    return Key_(batch[a]) < Key_(batch[b]);
+  });
+
+  std::vector<std::pair<size_type, bool>> res(batch.size());
+  vector<value_type> merged;
+  merged.reserve(data_.size() + batch.size());
+  iterator it = begin();
+  for (size_type i : order) {
+    const K &key = Key_(batch[i]);
+    while (it != end() && Key_(*it) < key) merged.push_back(std::move(*it++));
+    // An existing element with this key goes next; an equal key taken
+    // earlier from the batch was the last to go.
+    if (it != end() && !(key < Key_(*it))) {
+      res[i] = {merged.size(), false};
+    } else if (!merged.empty() && !(Key_(merged.back()) < key)) {
+      res[i] = {merged.size() - 1, false};
+    } else {
+      res[i] = {merged.size(), true};
+      merged.push_back(std::move(batch[i]));
+    }
+  }
+  while (it != end()) merged.push_back(std::move(*it++));
+  data_.swap(merged);
+  return res;
+}
+
+template <typename K, typename V>
+void FlatTree<K, V>::merge(FlatTree &other) {
+  if (this == &other) return;
+  std::vector<value_type> batch(std::make_move_iterator(other.begin()),
+                                std::make_move_iterator(other.end()));
+  other.clear();
+  MergeBatch_(batch);
+}
+
+template <typename K, typename V>
+typename FlatTree<K, V>::iterator FlatTree<K, V>::erase(const_iterator pos) {
+  return data_.erase(begin() + (pos - begin()));
+}
+
+template <typename K, typename V>
+typename FlatTree<K, V>::size_type FlatTree<K, V>::erase(const K &key) {
+  iterator it = find(key);
+  if (it == end()) return 0;
+  erase(it);
+  return 1;
+}
+}  // namespace s21
+
+#endif  // S21_FLAT_TREE_H_
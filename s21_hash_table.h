@@ -0,0 +1,573 @@
+#ifndef S21_HASH_TABLE_H_
+#define S21_HASH_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "s21_binary_tree.h"
+
+namespace s21 {
+// Open-addressing table behind unordered_map and unordered_set. Every slot
+// has a control byte: empty, deleted, or the low seven bits of the element's
+// hash. Slots are probed in aligned groups of sixteen, and one SSE2 compare
+// over a group's control bytes yields every slot whose hash bits match, so a
+// lookup usually reads one control group and one element. Groups are visited
+// in triangular order until one with an empty slot ends the probe.
+//
+// Elements never move except on rehash, which invalidates all iterators;
+// erasure invalidates only iterators to the erased element.
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class HashTable {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = typename TreeValue<K, V>::type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  // CONSTRUCTORS
+  HashTable();
+  explicit HashTable(size_type bucket_count, const Hash &hash = Hash(),
+                     const KeyEqual &equal = KeyEqual());
+  HashTable(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  HashTable(InputIt first, InputIt last);
+  HashTable(const HashTable &other);
+  HashTable(HashTable &&other) noexcept;
+
+  // DESTRUCTOR
+  virtual ~HashTable();
+
+  // BASIC METHODS
+  bool empty() const noexcept { return !size_; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept;
+  void clear() noexcept;
+  void swap(HashTable &other) noexcept;
+  // Makes room for count elements without a rehash.
+  void reserve(size_type count);
+  bool contains(const K &key) const;
+
+  // HASH POLICY
+  size_type bucket_count() const noexcept { return capacity_; }
+  float load_factor() const noexcept {
+    return capacity_ ? static_cast<float>(size_) / capacity_ : 0.0f;
+  }
+  float max_load_factor() const noexcept { return 0.875f; }
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return equal_; }
+
+  // OVERLOAD OPERATORS
+  HashTable &operator=(const HashTable &other);
+  HashTable &operator=(HashTable &&other) noexcept;
+
+ protected:
+  using ctrl_t = std::int8_t;
+
+  // Full slots hold the seven low hash bits, so every special value is
+  // negative. The sentinel follows the last slot and stops iteration.
+  static constexpr ctrl_t kEmpty = -128;
+  static constexpr ctrl_t kDeleted = -2;
+  static constexpr ctrl_t kSentinel = -1;
+  static constexpr size_type kGroupWidth = 16;
+
+  // Control bytes of one group. Each Match method returns a bitmask with bit
+  // i set when slot i of the group qualifies.
+  class Group_ {
+   public:
+#if defined(__SSE2__)
+    explicit Group_(const ctrl_t *pos)
+        : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+    std::uint32_t Match(ctrl_t h2) const {
+      return static_cast<std::uint32_t>(
+          _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+    }
+    std::uint32_t MatchEmptyOrDeleted() const {
+      return static_cast<std::uint32_t>(
+          _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_)));
+    }
+
+   private:
+    __m128i ctrl_;
+#else
+    explicit Group_(const ctrl_t *pos) {
+      std::memcpy(ctrl_, pos, kGroupWidth);
+    }
+    std::uint32_t Match(ctrl_t h2) const {
+      std::uint32_t mask = 0;
+      for (size_type i = 0; i < kGroupWidth; ++i)
+        if (ctrl_[i] == h2) mask |= 1u << i;
+      return mask;
+    }
+    std::uint32_t MatchEmptyOrDeleted() const {
+      std::uint32_t mask = 0;
+      for (size_type i = 0; i < kGroupWidth; ++i)
+        if (ctrl_[i] < kSentinel) mask |= 1u << i;
+      return mask;
+    }
+
+   private:
+    ctrl_t ctrl_[kGroupWidth];
+#endif
+
+   public:
+    std::uint32_t MatchEmpty() const { return Match(kEmpty); }
+  };
+
+  static size_type LowestBit_(std::uint32_t mask) noexcept {
+#if defined(__GNUC__)
+    return static_cast<size_type>(__builtin_ctz(mask));
+#else
+    size_type bit = 0;
+    while (!(mask & 1u)) mask >>= 1, ++bit;
+    return bit;
+#endif
+  }
+
+  // An iterator is a control byte and its slot; it skips to the next full
+  // slot or to the sentinel, which is end().
+  class ConstIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename HashTable::value_type;
+    using difference_type = typename HashTable::difference_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    ConstIterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+    ConstIterator(const ctrl_t *ctrl, value_type *slot) noexcept
+        : ctrl_(ctrl), slot_(slot) {}
+
+    bool operator==(const ConstIterator &other) const {
+      return ctrl_ == other.ctrl_;
+    }
+    bool operator!=(const ConstIterator &other) const {
+      return ctrl_ != other.ctrl_;
+    }
+    const_reference operator*() const { return *slot_; }
+    const value_type *operator->() const { return slot_; }
+    ConstIterator &operator++() {
+      OperationPlus_();
+      return *this;
+    }
+    ConstIterator operator++(int) {
+      ConstIterator tmp(*this);
+      OperationPlus_();
+      return tmp;
+    }
+    const ctrl_t *GetCtrl() const noexcept { return ctrl_; }
+    value_type *GetSlot() const noexcept { return slot_; }
+
+   protected:
+    friend class HashTable;
+    const ctrl_t *ctrl_;
+    value_type *slot_;
+    void OperationPlus_() {
+      ++ctrl_;
+      ++slot_;
+      SkipEmpty_();
+    }
+    void SkipEmpty_() {
+      while (*ctrl_ < kSentinel) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+  };
+
+  class Iterator : public ConstIterator {
+   public:
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    Iterator() noexcept : ConstIterator() {}
+    Iterator(const ctrl_t *ctrl, value_type *slot) noexcept
+        : ConstIterator(ctrl, slot) {}
+
+    typename HashTable::reference operator*() const { return *this->slot_; }
+    value_type *operator->() const { return this->slot_; }
+    Iterator &operator++() {
+      this->OperationPlus_();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator tmp(*this);
+      this->OperationPlus_();
+      return tmp;
+    }
+  };
+
+  static const K &Key_(const value_type &value) noexcept {
+    return TreeValue<K, V>::Key(value);
+  }
+
+  Iterator Find_(const K &key) const;
+  // Looks key up and, if it is absent, constructs value_type(args...) in a
+  // free slot on its probe path.
+  template <typename... Args>
+  std::pair<Iterator, bool> EmplaceKey_(const K &key, Args &&...args);
+
+ private:
+  ctrl_t *ctrl_;
+  value_type *slots_;
+  size_type capacity_;
+  size_type size_;
+  // Empty slots that can still be filled before the load factor is exceeded.
+  size_type growth_left_;
+  Hash hash_;
+  KeyEqual equal_;
+
+  static size_type MaxLoad_(size_type capacity) noexcept {
+    return capacity - capacity / 8;
+  }
+  static size_type CapacityFor_(size_type count) noexcept;
+  size_type Hash_(const K &key) const;
+  static ctrl_t H2_(size_type hash) noexcept {
+    return static_cast<ctrl_t>(hash & 0x7F);
+  }
+  size_type FindFreeSlot_(size_type hash) const noexcept;
+  void Rehash_(size_type capacity);
+  void Release_() noexcept;
+
+ public:
+  using const_iterator = ConstIterator;
+  using iterator = Iterator;
+
+  iterator begin() const noexcept;
+  iterator end() const noexcept {
+    return Iterator(ctrl_ + capacity_, slots_ + capacity_);
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void insert(InputIt first, InputIt last);
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+  iterator erase(const_iterator pos);
+  size_type erase(const K &key);
+
+  // LOOKUP
+  // find returns end() for a missing key.
+  iterator find(const K &key) const { return Find_(key); }
+};
+
+template <typename K, typename V, typename H, typename E>
+HashTable<K, V, H, E>::HashTable() : HashTable(0) {}
+
+template <typename K, typename V, typename H, typename E>
+HashTable<K, V, H, E>::HashTable(size_type bucket_count, const H &hash,
+                                 const E &equal)
+    : ctrl_(nullptr),
+      slots_(nullptr),
+      capacity_(0),
+      size_(0),
+      growth_left_(0),
+      hash_(hash),
+      equal_(equal) {
+  if (bucket_count) reserve(bucket_count);
+}
+
+template <typename K, typename V, typename H, typename E>
+HashTable<K, V, H, E>::HashTable(
+    std::initializer_list<value_type> const &items)
+    : HashTable(items.begin(), items.end()) {}
+
+template <typename K, typename V, typename H, typename E>
+template <typename InputIt, typename>
+HashTable<K, V, H, E>::HashTable(InputIt first, InputIt last) : HashTable() {
+  insert(first, last);
+}
+
+template <typename K, typename V, typename H, typename E>
+HashTable<K, V, H, E>::HashTable(const HashTable &other)
+    : HashTable(0, other.hash_, other.equal_) {
+  reserve(other.size_);
+  for (const value_type &value : other) EmplaceKey_(Key_(value), value);
+}
+
+template <typename K, typename V, typename H, typename E>
+HashTable<K, V, H, E>::HashTable(HashTable &&other) noexcept
+    : HashTable(0, other.hash_, other.equal_) {
+  swap(other);
+}
+
+template <typename K, typename V, typename H, typename E>
+HashTable<K, V, H, E>::~HashTable() {
+  Release_();
+}
+
+template <typename K, typename V, typename H, typename E>
+HashTable<K, V, H, E> &HashTable<K, V, H, E>::operator=(
+    const HashTable &other) {
+  if (this != &other) {
+    HashTable tmp(other);
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename H, typename E>
+HashTable<K, V, H, E> &HashTable<K, V, H, E>::operator=(
+    HashTable &&other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename H, typename E>
+typename HashTable<K, V, H, E>::size_type HashTable<K, V, H, E>::max_size()
+    const noexcept {
+  return std::numeric_limits<difference_type>::max() /
+         (sizeof(value_type) + 1);
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashTable<K, V, H, E>::clear() noexcept {
+  if (!capacity_) return;
+  for (size_type i = 0; i < capacity_; ++i)
+    if (ctrl_[i] >= 0) slots_[i].~value_type();
+  std::memset(ctrl_, static_cast<unsigned char>(kEmpty), capacity_);
+  size_ = 0;
+  growth_left_ = MaxLoad_(capacity_);
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashTable<K, V, H, E>::Release_() noexcept {
+  clear();
+  delete[] ctrl_;
+  std::allocator<value_type>().deallocate(slots_, capacity_);
+  ctrl_ = nullptr;
+  slots_ = nullptr;
+  capacity_ = growth_left_ = 0;
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashTable<K, V, H, E>::swap(HashTable &other) noexcept {
+  std::swap(ctrl_, other.ctrl_);
+  std::swap(slots_, other.slots_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(growth_left_, other.growth_left_);
+  std::swap(hash_, other.hash_);
+  std::swap(equal_, other.equal_);
+}
+
+// The smallest power of two, at least one group, whose load limit admits
+// count elements.
+template <typename K, typename V, typename H, typename E>
+typename HashTable<K, V, H, E>::size_type HashTable<K, V, H, E>::CapacityFor_(
+    size_type count) noexcept {
+  size_type capacity = kGroupWidth;
+  while (MaxLoad_(capacity) < count) capacity *= 2;
+  return capacity;
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashTable<K, V, H, E>::reserve(size_type count) {
+  if (count > max_size()) throw std::length_error("Too many elements");
+  if (count <= size_ + growth_left_) return;
+  Rehash_(CapacityFor_(count));
+}
+
+// Standard hashes of integers are often the identity, so the result is
+// scrambled with a Fibonacci multiply before its bits are split between the
+// probe start and the control byte.
+template <typename K, typename V, typename H, typename E>
+typename HashTable<K, V, H, E>::size_type HashTable<K, V, H, E>::Hash_(
+    const K &key) const {
+  std::uint64_t hash =
+      static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+  return static_cast<size_type>(hash ^ (hash >> 32));
+}
+
+template <typename K, typename V, typename H, typename E>
+typename HashTable<K, V, H, E>::iterator HashTable<K, V, H, E>::begin()
+    const noexcept {
+  Iterator it(ctrl_, slots_);
+  if (ctrl_) it.SkipEmpty_();
+  return it;
+}
+
+template <typename K, typename V, typename H, typename E>
+typename HashTable<K, V, H, E>::Iterator HashTable<K, V, H, E>::Find_(
+    const K &key) const {
+  if (!size_) return end();
+  size_type hash = Hash_(key);
+  size_type group_mask = capacity_ / kGroupWidth - 1;
+  size_type group = (hash >> 7) & group_mask;
+  for (size_type step = 1;; ++step) {
+    size_type base = group * kGroupWidth;
+    Group_ ctrl(ctrl_ + base);
+    for (std::uint32_t mask = ctrl.Match(H2_(hash)); mask; mask &= mask - 1) {
+      size_type pos = base + LowestBit_(mask);
+      if (equal_(Key_(slots_[pos]), key))
+        return Iterator(ctrl_ + pos, slots_ + pos);
+    }
+    if (ctrl.MatchEmpty()) return end();
+    group = (group + step) & group_mask;
+  }
+}
+
+// The load limit keeps at least one empty slot per eight, so the probe
+// always finds room.
+template <typename K, typename V, typename H, typename E>
+typename HashTable<K, V, H, E>::size_type HashTable<K, V, H, E>::FindFreeSlot_(
+    size_type hash) const noexcept {
+  size_type group_mask = capacity_ / kGroupWidth - 1;
+  size_type group = (hash >> 7) & group_mask;
+  for (size_type step = 1;; ++step) {
+    size_type base = group * kGroupWidth;
+    std::uint32_t mask = Group_(ctrl_ + base).MatchEmptyOrDeleted();
+    if (mask) return base + LowestBit_(mask);
+    group = (group + step) & group_mask;
+  }
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename... Args>
+std::pair<typename HashTable<K, V, H, E>::Iterator, bool>
+HashTable<K, V, H, E>::EmplaceKey_(const K &key, Args &&...args) {
+  Iterator it = Find_(key);
+  if (it != end()) return {it, false};
+  if (!growth_left_) {
+    // Mostly tombstones: rebuild at the same size instead of growing.
+    Rehash_(capacity_ && size_ * 2 <= MaxLoad_(capacity_)
+                ? capacity_
+                : CapacityFor_(size_ + 1));
+  }
+  size_type hash = Hash_(key);
+  size_type pos = FindFreeSlot_(hash);
+  ::new (static_cast<void *>(slots_ + pos))
+      value_type(std::forward<Args>(args)...);
+  if (ctrl_[pos] == kEmpty) --growth_left_;
+  ctrl_[pos] = H2_(hash);
+  ++size_;
+  return {Iterator(ctrl_ + pos, slots_ + pos), true};
+}
+
+// Moves every element into fresh arrays of the given capacity, dropping
+// tombstones. Elements whose move may throw are copied, and a failure
+// leaves the table as it was.
+template <typename K, typename V, typename H, typename E>
+void HashTable<K, V, H, E>::Rehash_(size_type capacity) {
+  HashTable fresh(0, hash_, equal_);
+  fresh.ctrl_ = new ctrl_t[capacity + 1];
+  std::memset(fresh.ctrl_, static_cast<unsigned char>(kEmpty), capacity);
+  fresh.ctrl_[capacity] = kSentinel;
+  try {
+    fresh.slots_ = std::allocator<value_type>().allocate(capacity);
+  } catch (...) {
+    delete[] fresh.ctrl_;
+    fresh.ctrl_ = nullptr;
+    throw;
+  }
+  fresh.capacity_ = capacity;
+  fresh.growth_left_ = MaxLoad_(capacity);
+  for (size_type i = 0; i < capacity_; ++i) {
+    if (ctrl_[i] < 0) continue;
+    size_type hash = Hash_(Key_(slots_[i]));
+    size_type pos = fresh.FindFreeSlot_(hash);
+    ::new (static_cast<void *>(fresh.slots_ + pos))
+        value_type(std::move_if_noexcept(slots_[i]));
+    fresh.ctrl_[pos] = H2_(hash);
+    --fresh.growth_left_;
+    ++fresh.size_;
+  }
+  swap(fresh);
+}
+
+template <typename K, typename V, typename H, typename E>
+bool HashTable<K, V, H, E>::contains(const K &key) const {
+  return Find_(key) != end();
+}
+
+template <typename K, typename V, typename H, typename E>
+std::pair<typename HashTable<K, V, H, E>::iterator, bool>
+HashTable<K, V, H, E>::insert(const value_type &value) {
+  return EmplaceKey_(Key_(value), value);
+}
+
+template <typename K, typename V, typename H, typename E>
+std::pair<typename HashTable<K, V, H, E>::iterator, bool>
+HashTable<K, V, H, E>::insert(value_type &&value) {
+  return EmplaceKey_(Key_(value), std::move(value));
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename InputIt, typename>
+void HashTable<K, V, H, E>::insert(InputIt first, InputIt last) {
+  if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                typename std::iterator_traits<
+                                    InputIt>::iterator_category>::value)
+    reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename... Args>
+std::vector<std::pair<typename HashTable<K, V, H, E>::iterator, bool>>
+HashTable<K, V, H, E>::insert_many(Args &&...args) {
+  reserve(size_ + sizeof...(args));
+  std::vector<std::pair<iterator, bool>> res_vec;
+  res_vec.reserve(sizeof...(args));
+  (res_vec.push_back(insert(value_type(std::forward<Args>(args)))), ...);
+  return res_vec;
+}
+
+// A slot whose group still has an empty slot can become empty again: no
+// probe ever passed through that group. Otherwise it must stay a tombstone
+// so that probes keep going past it.
+template <typename K, typename V, typename H, typename E>
+typename HashTable<K, V, H, E>::iterator HashTable<K, V, H, E>::erase(
+    const_iterator pos) {
+  size_type index = static_cast<size_type>(pos.GetCtrl() - ctrl_);
+  slots_[index].~value_type();
+  --size_;
+  if (Group_(ctrl_ + index / kGroupWidth * kGroupWidth).MatchEmpty()) {
+    ctrl_[index] = kEmpty;
+    ++growth_left_;
+  } else {
+    ctrl_[index] = kDeleted;
+  }
+  Iterator next(ctrl_ + index, slots_ + index);
+  ++next;
+  return next;
+}
+
+template <typename K, typename V, typename H, typename E>
+typename HashTable<K, V, H, E>::size_type HashTable<K, V, H, E>::erase(
+    const K &key) {
+  iterator it = Find_(key);
+  if (it == end()) return 0;
+  erase(it);
+  return 1;
+}
+}  // namespace s21
+
+#endif  // S21_HASH_TABLE_H_
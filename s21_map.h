@@ -1,85 +1,132 @@
+#ifndef S21_MAP_H_
+#define S21_MAP_H_
+
 #include "s21_binary_tree.h"
 
 namespace s21 {
-template <typename K, typename V>
-class map : public Tree<K, V> {
+// Ranked is the R flag of Tree, on by default; see there.
+template <typename K, typename V, typename Compare = std::less<>,
+          typename Allocator = std::allocator<std::pair<const K, V>>,
+          bool Ranked = true>
+class map : public Tree<K, V, Compare, Allocator, Ranked> {
+  using Tree_ = Tree<K, V, Compare, Allocator, Ranked>;
+
  public:
   // CONSTRUCTORS
-  map() : Tree<K, V>() {};
-  map(std::initializer_list<typename Tree<K, V>::value_type> const& items)
-      : Tree<K, V>(items) {};
-  map(const map& m) : Tree<K, V>(m) {};
-  map(map&& m) noexcept : Tree<K, V>(std::move(m)) {};
+  map() : Tree_() {};
+  explicit map(const Allocator& alloc) : Tree_(alloc) {}
+  explicit map(const Compare& comp, const Allocator& alloc = Allocator())
+      : Tree_(comp, alloc) {}
+  map(std::initializer_list<typename Tree_::value_type> const& items)
+      : Tree_(items) {};
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  map(InputIt first, InputIt last) : Tree_(first, last) {}
+  map(const map& m) : Tree_(m) {};
+  map(map&& m) noexcept : Tree_(std::move(m)) {};
 
   // DESTRUCTOR
   ~map() = default;
 
   // OVERLOAD OPERATORS
+  map& operator=(const map& m) {
+    Tree_::operator=(m);
+    return *this;
+  }
   map& operator=(map&& m) noexcept {
-    Tree<K, V>::operator=(std::move(m));
+    Tree_::operator=(std::move(m));
     return *this;
   }
 
-  V& operator[](const K& key) {
-    if (!this->contains(key)) {
-      std::pair<K, V> el{key, V()};
-      std::pair<typename Tree<K, V>::Iterator, bool> res_it = this->insert(el);
-      return res_it.first->second;
-    } else {
-      auto it = this->begin();
-      for (; it != this->end(); ++it)
-        if (it->first == key) return it->second;
-      return it->second;
-    }
+  V& operator[](const K& key) { return this->TryEmplace_(key).first->second; }
+  V& operator[](K&& key) {
+    return this->TryEmplace_(std::move(key)).first->second;
   }
 
   // BASIC METHODS
-  const V& at(const K& key) const {
-    V& res = (V&)fake;
-    auto tmp = this;
-    At_(key, res, (map<K, V>*)tmp);
-    return res;
+  using Tree_::erase;
+
+  // at and count look up any type comparable with K, as find does. at throws
+  // std::out_of_range for a missing key.
+  template <typename T = K>
+  V& at(const T& key) {
+    auto it = this->find(key);
+    if (it == this->end()) throw std::out_of_range("Key does not exist");
+    return it->second;
   }
-  std::pair<typename Tree<K, V>::Iterator, bool> insert(
-      const typename Tree<K, V>::value_type& value) noexcept override {
-    return Tree<K, V>::insert(value);
-  }
-  std::pair<typename Tree<K, V>::Iterator, bool> insert(const K& key,
-                                                        const V& obj) {
-    typename Tree<K, V>::Iterator it;
-    bool is_inserted = false;
-    std::pair<K, V> elem{key, obj};
-    this->Insert_(elem, it, is_inserted);
-    std::pair<typename Tree<K, V>::Iterator, bool> res = {it, is_inserted};
+  template <typename T = K>
+  const V& at(const T& key) const {
+    auto it = this->find(key);
+    if (it == this->end()) throw std::out_of_range("Key does not exist");
+    return it->second;
+  }
+  template <typename T = K>
+  typename Tree_::size_type count(const T& key) const {
+    return this->contains(key) ? 1 : 0;
+  }
+  template <typename T = K>
+  map extract_range(const T& lo, const T& hi) {
+    map res(this->key_comp(), this->get_allocator());
+    this->ExtractKeys_(lo, hi, res);
     return res;
   }
-  std::pair<typename Tree<K, V>::Iterator, bool> insert_or_assign(
+  typename Tree_::size_type erase(const K& key) {
+    Node_* node = this->Find_(key);
+    if (!node) return 0;
+    Tree_::erase(typename Tree_::iterator(node, this));
+    return 1;
+  }
+  std::pair<typename Tree_::Iterator, bool> insert(
+      const typename Tree_::value_type& value) {
+    return Tree_::insert(value);
+  }
+  std::pair<typename Tree_::Iterator, bool> insert(
+      typename Tree_::value_type&& value) {
+    return Tree_::insert(std::move(value));
+  }
+  typename Tree_::iterator insert(typename Tree_::const_iterator hint,
+                                  const typename Tree_::value_type& value) {
+    return Tree_::insert(hint, value);
+  }
+  typename Tree_::iterator insert(typename Tree_::const_iterator hint,
+                                  typename Tree_::value_type&& value) {
+    return Tree_::insert(hint, std::move(value));
+  }
+  typename Tree_::insert_return_type insert(
+      typename Tree_::node_type&& node) {
+    return Tree_::insert(std::move(node));
+  }
+  typename Tree_::iterator insert(typename Tree_::const_iterator hint,
+                                  typename Tree_::node_type&& node) {
+    return Tree_::insert(hint, std::move(node));
+  }
+  std::pair<typename Tree_::Iterator, bool> insert(const K& key,
+                                                   const V& obj) {
+    return this->TryEmplace_(key, obj);
+  }
+  std::pair<typename Tree_::Iterator, bool> insert_or_assign(
       const K& key, const V& obj) {
-    std::pair<typename Tree<K, V>::Iterator, bool> res_it;
+    std::pair<typename Tree_::Iterator, bool> res_it;
     res_it = insert(key, obj);
-    if (!res_it.second) {
-      auto it = this->begin();
-      while (it->first != key) ++it;
-      res_it.first.SetTree(it.GetTree());
-      res_it.first->second = obj;
-    }
+    if (!res_it.second) res_it.first->second = obj;
     return res_it;
   }
+  // try_emplace leaves args untouched when key is already present, and
+  // otherwise builds the mapped value from them inside the new node.
+  template <typename... Args>
+  std::pair<typename Tree_::Iterator, bool> try_emplace(const K& key,
+                                                        Args&&... args) {
+    return this->TryEmplace_(key, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::pair<typename Tree_::Iterator, bool> try_emplace(K&& key,
+                                                        Args&&... args) {
+    return this->TryEmplace_(std::move(key), std::forward<Args>(args)...);
+  }
 
  private:
-  V fake = V();
-  void At_(const K& key, V& res, map<K, V>* tr) const {
-    if (!tr->root_ ||
-        (!tr->left_ && !tr->right_ && tr->root_->element_.first != key))
-      throw std::out_of_range("Key does not exist");
-
-    if (key < tr->root_->element_.first) {
-      map<K, V>::At_(key, res, (map<K, V>*)tr->left_);
-    } else if (key > tr->root_->element_.first) {
-      map<K, V>::At_(key, res, (map<K, V>*)tr->right_);
-    } else {
-      res = tr->root_->element_.second;
-    }
-  }
+  using Node_ = typename Tree_::Node_;
 };
-}  // namespace s21
\ No newline at end of file
+}  // namespace s21
+
+#endif  // S21_MAP_H_
@@ -1,33 +1,128 @@
+#ifndef S21_MULTISET_H_
+#define S21_MULTISET_H_
+
 #include "s21_set.h"
 
 namespace s21 {
-template <typename K>
-class multiset : public set<K> {
+// Ranked is the R flag of Tree, on by default; see there.
+template <typename K, typename Compare = std::less<>,
+          typename Allocator = std::allocator<K>, bool Ranked = true>
+class multiset : public set<K, Compare, Allocator, Ranked> {
+  using Set_ = set<K, Compare, Allocator, Ranked>;
+
  public:
-  using key_type = typename set<K>::key_type;
-  using value_type = typename set<K>::value_type;
+  using key_type = typename Set_::key_type;
+  using value_type = typename Set_::value_type;
 
-  multiset() : set<K>() {}
-  multiset(std::initializer_list<value_type> const &items) : set<K>(items) {}
-  multiset(const multiset &s) : set<K>(s) {};
-  multiset(multiset &&s) noexcept : set<K>(std::move(s)) {};
+  multiset() : Set_() {}
+  explicit multiset(const Allocator &alloc) : Set_(alloc) {}
+  explicit multiset(const Compare &comp, const Allocator &alloc = Allocator())
+      : Set_(comp, alloc) {}
+  multiset(std::initializer_list<value_type> const &items) : Set_() {
+    this->Assign_(items.begin(), items.end(), false);
+  }
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  multiset(InputIt first, InputIt last) : Set_() {
+    this->Assign_(first, last, false);
+  }
+  multiset(const multiset &s) : Set_(s) {};
+  multiset(multiset &&s) noexcept : Set_(std::move(s)) {};
   ~multiset() = default;
 
+  multiset &operator=(const multiset &s) {
+    Set_::operator=(s);
+    return *this;
+  }
   multiset &operator=(multiset &&s) noexcept {
-    set<K>::operator=(std::move(s));
+    Set_::operator=(std::move(s));
     return *this;
   }
 
-  std::pair<typename set<K>::iterator, bool> Insert(
-      const value_type &value) noexcept {
-    std::pair<key_type, value_type> tmp_el{value, value};
-    typename Tree<K, K>::iterator tree_it;
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    this->Assign_(first, last, false);
+  }
+
+  // Every insertion keeps equal keys, each going in after those already
+  // present; insert and emplace still return a pair for symmetry with set,
+  // its bool always true. emplace and insert_many build each element in its
+  // node.
+  std::pair<typename Set_::iterator, bool> insert(const value_type &value) {
+    return Insert(value);
+  }
+  std::pair<typename Set_::iterator, bool> insert(value_type &&value) {
+    return this->Emplace_(false, std::move(value));
+  }
+  template <typename... Args>
+  std::pair<typename Set_::iterator, bool> emplace(Args &&...args) {
+    return this->Emplace_(false, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::vector<std::pair<typename Set_::iterator, bool>> insert_many(
+      Args &&...args) {
+    std::vector<std::pair<typename Set_::iterator, bool>> res_vec;
+    res_vec.reserve(sizeof...(args));
+    (res_vec.push_back(this->Emplace_(false, std::forward<Args>(args))), ...);
+    return res_vec;
+  }
+  typename Set_::iterator insert(typename Set_::const_iterator hint,
+                                 const value_type &value) {
+    return this->HintInsert_(hint, value, false);
+  }
+  typename Set_::iterator insert(typename Set_::const_iterator hint,
+                                 value_type &&value) {
+    return this->HintInsert_(hint, std::move(value), false);
+  }
+  // A node always goes in, so only the position comes back.
+  typename Set_::iterator insert(typename Set_::node_type &&node) {
+    return this->InsertNode_(node, false).first;
+  }
+  typename Set_::iterator insert(typename Set_::const_iterator hint,
+                                 typename Set_::node_type &&node) {
+    return this->HintInsertNode_(hint, node, false);
+  }
+  template <typename... Args>
+  typename Set_::iterator emplace_hint(typename Set_::const_iterator hint,
+                                       Args &&...args) {
+    return this->HintInsert_(hint, value_type(std::forward<Args>(args)...),
+                             false);
+  }
+  template <typename InputIt>
+  void append_sorted(InputIt first, InputIt last) {
+    this->AppendSorted_(first, last, false);
+  }
+
+  // Erases every element equal to key and returns how many there were. Each
+  // copy is a node of its own, cut out together as a range in O(k + log n)
+  // for k copies; counted_multiset drops them all in O(log n).
+  using Set_::erase;
+  typename Set_::size_type erase(const K &key) {
+    auto range = this->equal_range(key);
+    typename Set_::size_type before = this->size();
+    this->erase(range.first, range.second);
+    return before - this->size();
+  }
+  template <typename T = K>
+  multiset extract_range(const T &lo, const T &hi) {
+    multiset res(this->key_comp(), this->get_allocator());
+    this->ExtractKeys_(lo, hi, res);
+    return res;
+  }
+
+  // Keeps every element of other, equal keys included.
+  void merge(multiset &other) { this->Merge_(other, false); }
+  // The first key of other may equal the last key of *this.
+  void join(multiset &other) { this->Join_(other, false); }
+
+  std::pair<typename Set_::iterator, bool> Insert(const value_type &value) {
+    typename Tree<K, KeyOnly, Compare, Allocator, Ranked>::iterator tree_it;
     bool is_inserted = false;
-    std::pair<K, K> val{value, value};
-    this->MultiSetInsert_(val, tree_it, is_inserted);
-    typename set<K>::SetIterator set_it(tree_it);
-    std::pair<typename set<K>::SetIterator, bool> res{set_it, is_inserted};
+    this->MultiSetInsert_(value, tree_it, is_inserted);
+    std::pair<typename Set_::iterator, bool> res{tree_it, is_inserted};
     return res;
   }
 };
 }  // namespace s21
+
+#endif  // S21_MULTISET_H_
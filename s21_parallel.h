@@ -0,0 +1,123 @@
+#ifndef S21_PARALLEL_H_
+#define S21_PARALLEL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+// Parallel algorithms over map, set and multiset. The tree is cut into
+// contiguous ranges with Tree::slices: equal in size by rank when the tree
+// keeps order statistics, as it does by default, and a subtree each
+// otherwise, in which case the ranges may differ in size several-fold.
+// Either way forming the ranges costs next to nothing and the threads share
+// only the ancestors they read. Each range runs on a thread of its own, and
+// the calling thread takes the first one.
+//
+// threads is the most threads to use, 0 meaning one per hardware thread.
+// Ranges are never smaller than kParallelGrain elements, so a small tree is
+// processed on the calling thread alone. The functions passed in run
+// concurrently and must not insert or erase; if any of them throws, the
+// first exception by range order is rethrown once every thread has joined.
+constexpr std::size_t kParallelGrain = 4096;
+
+inline std::size_t ParallelThreads_(std::size_t threads) {
+  return threads ? threads
+                 : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Calls chunk(first, last, index) for each of the ranges, concurrently.
+template <typename Tree, typename F>
+std::size_t ParallelChunks_(Tree &tree, std::size_t threads, F &&chunk) {
+  std::size_t size = tree.size();
+  std::size_t count = std::max<std::size_t>(
+      1, std::min(ParallelThreads_(threads), size / kParallelGrain));
+
+  using Iter = decltype(tree.begin());
+  std::vector<Iter> bounds;
+  for (auto &first : tree.slices(count)) bounds.push_back(Iter(first));
+  if (bounds.empty()) bounds.push_back(tree.begin());
+  bounds.push_back(tree.end());
+  count = bounds.size() - 1;
+
+  std::vector<std::exception_ptr> errors(count);
+  auto run = [&](std::size_t i) {
+    try {
+      chunk(bounds[i], bounds[i + 1], i);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(count - 1);
+  for (std::size_t i = 1; i < count; ++i) workers.emplace_back(run, i);
+  run(0);
+  for (std::thread &worker : workers) worker.join();
+  for (std::exception_ptr &error : errors)
+    if (error) std::rethrow_exception(error);
+  return count;
+}
+
+// Calls f with every element. f gets a mutable reference through a map,
+// so it may change mapped values, though never keys.
+template <typename Tree, typename F>
+void parallel_for_each(Tree &tree, F f, std::size_t threads = 0) {
+  ParallelChunks_(tree, threads, [&f](auto first, auto last, std::size_t) {
+    for (; first != last; ++first) f(*first);
+  });
+}
+
+// Folds transform(element) over the tree with reduce, starting from init.
+// Ranges are reduced separately and their results combined in key order, so
+// reduce has to be associative but need not be commutative.
+template <typename Tree, typename T, typename Reduce, typename Transform>
+T parallel_reduce(const Tree &tree, T init, Reduce reduce,
+                  Transform transform, std::size_t threads = 0) {
+  std::vector<std::optional<T>> partial(ParallelThreads_(threads));
+  std::size_t count = ParallelChunks_(
+      tree, threads, [&](auto first, auto last, std::size_t i) {
+        if (first == last) return;
+        T acc = transform(*first);
+        for (++first; first != last; ++first)
+          acc = reduce(std::move(acc), transform(*first));
+        partial[i].emplace(std::move(acc));
+      });
+  for (std::size_t i = 0; i < count; ++i)
+    if (partial[i]) init = reduce(std::move(init), std::move(*partial[i]));
+  return init;
+}
+
+template <typename Tree, typename Pred>
+std::size_t parallel_count_if(const Tree &tree, Pred pred,
+                              std::size_t threads = 0) {
+  return parallel_reduce(
+      tree, std::size_t(0), [](std::size_t a, std::size_t b) { return a + b; },
+      [&pred](const auto &elem) -> std::size_t { return pred(elem) ? 1 : 0; },
+      threads);
+}
+
+// pred is evaluated in parallel; the matching elements are then erased on
+// the calling thread with Tree::erase_many, since the tree itself is not
+// thread-safe, so erasing many of them rebuilds the tree once rather than
+// rebalancing after each. Returns how many were erased.
+template <typename Tree, typename Pred>
+std::size_t parallel_erase_if(Tree &tree, Pred pred, std::size_t threads = 0) {
+  using Iter = decltype(tree.begin());
+  std::vector<std::vector<Iter>> doomed(ParallelThreads_(threads));
+  std::size_t count = ParallelChunks_(
+      tree, threads, [&](Iter first, Iter last, std::size_t i) {
+        for (; first != last; ++first)
+          if (pred(*first)) doomed[i].push_back(first);
+      });
+  std::vector<typename Tree::const_iterator> positions;
+  for (std::size_t i = 0; i < count; ++i)
+    positions.insert(positions.end(), doomed[i].begin(), doomed[i].end());
+  return tree.erase_many(positions);
+}
+}  // namespace s21
+
+#endif  // S21_PARALLEL_H_
@@ -0,0 +1,68 @@
+#ifndef S21_PERSISTENT_MAP_H_
+#define S21_PERSISTENT_MAP_H_
+
+#include <stdexcept>
+
+#include "s21_persistent_tree.h"
+
+namespace s21 {
+template <typename K, typename V, typename Compare = std::less<>,
+          typename Allocator = std::allocator<std::pair<const K, V>>>
+class persistent_map : public PersistentTree<K, V, Compare, Allocator> {
+  using Tree_ = PersistentTree<K, V, Compare, Allocator>;
+
+ public:
+  using typename Tree_::value_type;
+  using typename Tree_::size_type;
+  using typename Tree_::iterator;
+  using typename Tree_::const_iterator;
+
+  // CONSTRUCTORS
+  persistent_map() : Tree_() {}
+  explicit persistent_map(const Compare &comp,
+                          const Allocator &alloc = Allocator())
+      : Tree_(comp, alloc) {}
+  persistent_map(std::initializer_list<value_type> const &items)
+      : Tree_(items) {}
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  persistent_map(InputIt first, InputIt last) : Tree_(first, last) {}
+  persistent_map(const persistent_map &m) noexcept : Tree_(m) {}
+  persistent_map(persistent_map &&m) noexcept : Tree_(std::move(m)) {}
+
+  // DESTRUCTOR
+  ~persistent_map() = default;
+
+  // OVERLOAD OPERATORS
+  persistent_map &operator=(const persistent_map &m) noexcept {
+    Tree_::operator=(m);
+    return *this;
+  }
+  persistent_map &operator=(persistent_map &&m) noexcept {
+    Tree_::operator=(std::move(m));
+    return *this;
+  }
+
+  // BASIC METHODS
+  // The version as it is now, sharing every node with *this.
+  persistent_map snapshot() const noexcept { return *this; }
+
+  // Values are read-only, since a node may belong to other versions;
+  // insert_or_assign is the way to change one.
+  const V &at(const K &key) const {
+    iterator it = this->find(key);
+    if (it == this->end()) throw std::out_of_range("Key does not exist");
+    return it->second;
+  }
+  size_type count(const K &key) const { return this->contains(key) ? 1 : 0; }
+  using Tree_::insert;
+  std::pair<iterator, bool> insert(const K &key, const V &obj) {
+    return this->Insert_(key, false, key, obj);
+  }
+  std::pair<iterator, bool> insert_or_assign(const K &key, const V &obj) {
+    return this->Insert_(key, true, key, obj);
+  }
+};
+}  // namespace s21
+
+#endif  // S21_PERSISTENT_MAP_H_
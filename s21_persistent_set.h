@@ -0,0 +1,51 @@
+#ifndef S21_PERSISTENT_SET_H_
+#define S21_PERSISTENT_SET_H_
+
+#include "s21_persistent_tree.h"
+
+namespace s21 {
+template <typename K, typename Compare = std::less<>,
+          typename Allocator = std::allocator<K>>
+class persistent_set : public PersistentTree<K, KeyOnly, Compare, Allocator> {
+  using Tree_ = PersistentTree<K, KeyOnly, Compare, Allocator>;
+
+ public:
+  using typename Tree_::value_type;
+  using typename Tree_::size_type;
+  using typename Tree_::iterator;
+  using typename Tree_::const_iterator;
+
+  // CONSTRUCTORS
+  persistent_set() : Tree_() {}
+  explicit persistent_set(const Compare &comp,
+                          const Allocator &alloc = Allocator())
+      : Tree_(comp, alloc) {}
+  persistent_set(std::initializer_list<value_type> const &items)
+      : Tree_(items) {}
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  persistent_set(InputIt first, InputIt last) : Tree_(first, last) {}
+  persistent_set(const persistent_set &s) noexcept : Tree_(s) {}
+  persistent_set(persistent_set &&s) noexcept : Tree_(std::move(s)) {}
+
+  // DESTRUCTOR
+  ~persistent_set() = default;
+
+  // OVERLOAD OPERATORS
+  persistent_set &operator=(const persistent_set &s) noexcept {
+    Tree_::operator=(s);
+    return *this;
+  }
+  persistent_set &operator=(persistent_set &&s) noexcept {
+    Tree_::operator=(std::move(s));
+    return *this;
+  }
+
+  // BASIC METHODS
+  // The version as it is now, sharing every node with *this.
+  persistent_set snapshot() const noexcept { return *this; }
+  size_type count(const K &key) const { return this->contains(key) ? 1 : 0; }
+};
+}  // namespace s21
+
+#endif  // S21_PERSISTENT_SET_H_
@@ -0,0 +1,540 @@
+#ifndef S21_PERSISTENT_TREE_H_
+#define S21_PERSISTENT_TREE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "s21_binary_tree.h"
+
+namespace s21 {
+// AVL tree of immutable nodes behind persistent_map and persistent_set. An
+// update never writes to a node: it builds new copies of the nodes on the
+// path from the root to the changed leaf, rebalancing on the way up, and the
+// new path points at the untouched subtrees of the old one. Each update so
+// allocates O(log n) nodes and copies O(log n) elements, and every earlier
+// version stays intact for as long as something holds it.
+//
+// Copying a tree, or taking snapshot() of it, shares the root and is O(1).
+// Nodes are reference counted atomically, so a snapshot can be read from
+// other threads while the writer keeps updating the original; the tree
+// object itself is not synchronised, and taking a snapshot counts as a read
+// of it. Iterators stay valid while the version they came from is alive; an
+// update frees the nodes it replaced unless a snapshot still holds them.
+template <typename K, typename V, typename C = std::less<>,
+          typename A = std::allocator<typename TreeValue<K, V>::type>>
+class PersistentTree {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = typename TreeValue<K, V>::type;
+  using key_compare = C;
+  using allocator_type = A;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+ protected:
+  // refs_ counts the trees and parent nodes pointing at the node. It sits in
+  // the padding after height_.
+  struct Node_ {
+    value_type element_;
+    const Node_ *left_;
+    const Node_ *right_;
+    unsigned char height_;
+    mutable std::atomic<std::uint32_t> refs_;
+    template <typename... Args>
+    Node_(const Node_ *left, const Node_ *right, Args &&...args)
+        : element_(std::forward<Args>(args)...),
+          left_(left),
+          right_(right),
+          height_(1 + std::max(Height_(left), Height_(right))),
+          refs_(1) {}
+  };
+
+  using NodeAllocator_ =
+      typename std::allocator_traits<A>::template rebind_alloc<Node_>;
+  using NodeTraits_ = std::allocator_traits<NodeAllocator_>;
+
+  // Nodes have no parent links, as a node may sit in many trees at once, so
+  // an iterator keeps the path from the root down to its node. An AVL tree
+  // of 2^44 elements is at most 63 levels high.
+  static constexpr int kMaxHeight_ = 64;
+
+ public:
+  class ConstIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = PersistentTree::value_type;
+    using difference_type = PersistentTree::difference_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    ConstIterator() noexcept : root_(nullptr), depth_(0) {}
+
+    bool operator==(const ConstIterator &other) const {
+      return depth_ == other.depth_ &&
+             (!depth_ || path_[depth_ - 1] == other.path_[depth_ - 1]);
+    }
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    }
+    reference operator*() const { return path_[depth_ - 1]->element_; }
+    pointer operator->() const { return &path_[depth_ - 1]->element_; }
+    ConstIterator &operator++();
+    ConstIterator operator++(int) {
+      ConstIterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+    ConstIterator &operator--();
+    ConstIterator operator--(int) {
+      ConstIterator tmp(*this);
+      --*this;
+      return tmp;
+    }
+
+   private:
+    friend class PersistentTree;
+    explicit ConstIterator(const Node_ *root) noexcept
+        : root_(root), depth_(0) {}
+    void Descend_(const Node_ *node, bool left) {
+      for (; node; node = left ? node->left_ : node->right_)
+        path_[depth_++] = node;
+    }
+
+    const Node_ *root_;
+    int depth_;
+    const Node_ *path_[kMaxHeight_];
+  };
+
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+  // CONSTRUCTORS
+  PersistentTree() : root_(nullptr), size_(0), alloc_(), comp_() {}
+  explicit PersistentTree(const C &comp, const A &alloc = A())
+      : root_(nullptr), size_(0), alloc_(alloc), comp_(comp) {}
+  PersistentTree(std::initializer_list<value_type> const &items)
+      : PersistentTree(items.begin(), items.end()) {}
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  PersistentTree(InputIt first, InputIt last) : PersistentTree() {
+    for (; first != last; ++first) insert(*first);
+  }
+  PersistentTree(const PersistentTree &other) noexcept
+      : root_(Retain_(other.root_)),
+        size_(other.size_),
+        alloc_(other.alloc_),
+        comp_(other.comp_) {}
+  PersistentTree(PersistentTree &&other) noexcept
+      : root_(other.root_),
+        size_(other.size_),
+        alloc_(std::move(other.alloc_)),
+        comp_(std::move(other.comp_)) {
+    other.root_ = nullptr;
+    other.size_ = 0;
+  }
+
+  // DESTRUCTOR
+  virtual ~PersistentTree() { Release_(root_); }
+
+  // OVERLOAD OPERATORS
+  PersistentTree &operator=(const PersistentTree &other) noexcept;
+  PersistentTree &operator=(PersistentTree &&other) noexcept;
+
+  // BASIC METHODS
+  bool empty() const noexcept { return !size_; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(Node_);
+  }
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+  key_compare key_comp() const { return comp_; }
+  void clear() noexcept;
+  void swap(PersistentTree &other) noexcept;
+
+  iterator begin() const noexcept;
+  iterator end() const noexcept { return iterator(root_); }
+
+  // Both return whether the tree changed. An insert of a key already present
+  // and an erase of a missing key allocate nothing.
+  std::pair<iterator, bool> insert(const value_type &value);
+  size_type erase(const K &key);
+
+  // LOOKUP
+  // find returns end() for a missing key, and the bounds return end() when
+  // no element qualifies.
+  bool contains(const K &key) const { return find(key) != end(); }
+  iterator find(const K &key) const;
+  iterator lower_bound(const K &key) const { return Bound_(key, false); }
+  iterator upper_bound(const K &key) const { return Bound_(key, true); }
+
+ protected:
+  const Node_ *root_;
+  size_type size_;
+  NodeAllocator_ alloc_;
+  C comp_;
+
+  static const K &Key_(const Node_ *node) noexcept {
+    return TreeValue<K, V>::Key(node->element_);
+  }
+  static int Height_(const Node_ *node) noexcept {
+    return node ? node->height_ : 0;
+  }
+
+  // Replaces the element of an existing key when assign is set.
+  template <typename... Args>
+  std::pair<iterator, bool> Insert_(const K &key, bool assign,
+                                    Args &&...args);
+
+ private:
+  static const Node_ *Retain_(const Node_ *node) noexcept;
+  void Release_(const Node_ *node) noexcept;
+  template <typename... Args>
+  const Node_ *NewNode_(const Node_ *left, const Node_ *right, Args &&...args);
+  template <typename... Args>
+  const Node_ *Balance_(const Node_ *left, const Node_ *right, Args &&...args);
+  template <typename... Args>
+  const Node_ *InsertInto_(const Node_ *node, const K &key, bool assign,
+                           bool &inserted, Args &&...args);
+  const Node_ *EraseFrom_(const Node_ *node, const K &key);
+  const Node_ *EraseMin_(const Node_ *node);
+  iterator Bound_(const K &key, bool upper) const;
+};
+
+template <typename K, typename V, typename C, typename A>
+typename PersistentTree<K, V, C, A>::ConstIterator &
+PersistentTree<K, V, C, A>::ConstIterator::operator++() {
+  const Node_ *node = path_[depth_ - 1];
+  if (node->right_) {
+    Descend_(node->right_, true);
+    return *this;
+  }
+  while (depth_ > 1 && path_[depth_ - 2]->right_ == path_[depth_ - 1])
+    --depth_;
+  --depth_;
+  return *this;
+}
+
+// --end() steps to the largest element, found from the root.
+template <typename K, typename V, typename C, typename A>
+typename PersistentTree<K, V, C, A>::ConstIterator &
+PersistentTree<K, V, C, A>::ConstIterator::operator--() {
+  if (!depth_) {
+    Descend_(root_, false);
+    return *this;
+  }
+  const Node_ *node = path_[depth_ - 1];
+  if (node->left_) {
+    Descend_(node->left_, false);
+    return *this;
+  }
+  while (depth_ > 1 && path_[depth_ - 2]->left_ == path_[depth_ - 1])
+    --depth_;
+  --depth_;
+  return *this;
+}
+
+template <typename K, typename V, typename C, typename A>
+PersistentTree<K, V, C, A> &PersistentTree<K, V, C, A>::operator=(
+    const PersistentTree &other) noexcept {
+  if (this != &other) {
+    const Node_ *old = root_;
+    root_ = Retain_(other.root_);
+    size_ = other.size_;
+    alloc_ = other.alloc_;
+    comp_ = other.comp_;
+    Release_(old);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename C, typename A>
+PersistentTree<K, V, C, A> &PersistentTree<K, V, C, A>::operator=(
+    PersistentTree &&other) noexcept {
+  if (this != &other) {
+    swap(other);
+    other.clear();
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename C, typename A>
+void PersistentTree<K, V, C, A>::clear() noexcept {
+  Release_(root_);
+  root_ = nullptr;
+  size_ = 0;
+}
+
+template <typename K, typename V, typename C, typename A>
+void PersistentTree<K, V, C, A>::swap(PersistentTree &other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+  std::swap(alloc_, other.alloc_);
+  std::swap(comp_, other.comp_);
+}
+
+template <typename K, typename V, typename C, typename A>
+typename PersistentTree<K, V, C, A>::iterator
+PersistentTree<K, V, C, A>::begin() const noexcept {
+  iterator it(root_);
+  it.Descend_(root_, true);
+  return it;
+}
+
+template <typename K, typename V, typename C, typename A>
+typename PersistentTree<K, V, C, A>::iterator
+PersistentTree<K, V, C, A>::find(const K &key) const {
+  iterator it = lower_bound(key);
+  return it != end() && !comp_(key, Key_(it.path_[it.depth_ - 1])) ? it
+                                                                   : end();
+}
+
+// The descent records its path; the bound is the last node where it turned
+// left, and the path is cut back to it.
+template <typename K, typename V, typename C, typename A>
+typename PersistentTree<K, V, C, A>::iterator
+PersistentTree<K, V, C, A>::Bound_(const K &key, bool upper) const {
+  iterator it(root_);
+  int depth = 0;
+  for (const Node_ *node = root_; node;) {
+    it.path_[it.depth_++] = node;
+    bool left = upper ? comp_(key, Key_(node)) : !comp_(Key_(node), key);
+    if (left) depth = it.depth_;
+    node = left ? node->left_ : node->right_;
+  }
+  it.depth_ = depth;
+  return it;
+}
+
+template <typename K, typename V, typename C, typename A>
+std::pair<typename PersistentTree<K, V, C, A>::iterator, bool>
+PersistentTree<K, V, C, A>::insert(const value_type &value) {
+  return Insert_(TreeValue<K, V>::Key(value), false, value);
+}
+
+// The result points into the new version, so it is looked up once more
+// after the update.
+template <typename K, typename V, typename C, typename A>
+template <typename... Args>
+std::pair<typename PersistentTree<K, V, C, A>::iterator, bool>
+PersistentTree<K, V, C, A>::Insert_(const K &key, bool assign,
+                                    Args &&...args) {
+  bool inserted = false;
+  const Node_ *root =
+      InsertInto_(root_, key, assign, inserted, std::forward<Args>(args)...);
+  Release_(root_);
+  root_ = root;
+  if (inserted) ++size_;
+  return {find(key), inserted};
+}
+
+template <typename K, typename V, typename C, typename A>
+typename PersistentTree<K, V, C, A>::size_type
+PersistentTree<K, V, C, A>::erase(const K &key) {
+  size_type old_size = size_;
+  const Node_ *root = EraseFrom_(root_, key);
+  Release_(root_);
+  root_ = root;
+  return old_size - size_;
+}
+
+template <typename K, typename V, typename C, typename A>
+const typename PersistentTree<K, V, C, A>::Node_ *
+PersistentTree<K, V, C, A>::Retain_(const Node_ *node) noexcept {
+  if (node) node->refs_.fetch_add(1, std::memory_order_relaxed);
+  return node;
+}
+
+// The last reference frees the node and lets go of its children in turn, so
+// the recursion is never deeper than the tree.
+template <typename K, typename V, typename C, typename A>
+void PersistentTree<K, V, C, A>::Release_(const Node_ *node) noexcept {
+  if (!node || node->refs_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    return;
+  Release_(node->left_);
+  Release_(node->right_);
+  Node_ *dead = const_cast<Node_ *>(node);
+  NodeTraits_::destroy(alloc_, dead);
+  NodeTraits_::deallocate(alloc_, dead, 1);
+}
+
+// Takes over the references to left and right, and gives them up again if
+// the element cannot be built.
+template <typename K, typename V, typename C, typename A>
+template <typename... Args>
+const typename PersistentTree<K, V, C, A>::Node_ *
+PersistentTree<K, V, C, A>::NewNode_(const Node_ *left, const Node_ *right,
+                                     Args &&...args) {
+  Node_ *node = NodeTraits_::allocate(alloc_, 1);
+  try {
+    NodeTraits_::construct(alloc_, node, left, right,
+                           std::forward<Args>(args)...);
+  } catch (...) {
+    NodeTraits_::deallocate(alloc_, node, 1);
+    Release_(left);
+    Release_(right);
+    throw;
+  }
+  return node;
+}
+
+// Builds a node from args over left and right, whose heights differ by at
+// most two after a single insertion or erasure below, and rotates when they
+// differ by two. Rotated nodes are shared with older versions, so a rotation
+// copies them rather than relinking them. Takes over left and right.
+template <typename K, typename V, typename C, typename A>
+template <typename... Args>
+const typename PersistentTree<K, V, C, A>::Node_ *
+PersistentTree<K, V, C, A>::Balance_(const Node_ *left, const Node_ *right,
+                                     Args &&...args) {
+  int balance = Height_(left) - Height_(right);
+  if (balance > 1) {
+    const Node_ *res;
+    try {
+      if (Height_(left->left_) >= Height_(left->right_)) {
+        const Node_ *lower = NewNode_(Retain_(left->right_), right,
+                                      std::forward<Args>(args)...);
+        res = NewNode_(Retain_(left->left_), lower, left->element_);
+      } else {
+        const Node_ *mid = left->right_;
+        const Node_ *lower_right = NewNode_(Retain_(mid->right_), right,
+                                            std::forward<Args>(args)...);
+        const Node_ *lower_left;
+        try {
+          lower_left = NewNode_(Retain_(left->left_), Retain_(mid->left_),
+                                left->element_);
+        } catch (...) {
+          Release_(lower_right);
+          throw;
+        }
+        res = NewNode_(lower_left, lower_right, mid->element_);
+      }
+    } catch (...) {
+      Release_(left);
+      throw;
+    }
+    Release_(left);
+    return res;
+  }
+  if (balance < -1) {
+    const Node_ *res;
+    try {
+      if (Height_(right->right_) >= Height_(right->left_)) {
+        const Node_ *lower = NewNode_(left, Retain_(right->left_),
+                                      std::forward<Args>(args)...);
+        res = NewNode_(lower, Retain_(right->right_), right->element_);
+      } else {
+        const Node_ *mid = right->left_;
+        const Node_ *lower_left = NewNode_(left, Retain_(mid->left_),
+                                           std::forward<Args>(args)...);
+        const Node_ *lower_right;
+        try {
+          lower_right = NewNode_(Retain_(mid->right_), Retain_(right->right_),
+                                 right->element_);
+        } catch (...) {
+          Release_(lower_left);
+          throw;
+        }
+        res = NewNode_(lower_left, lower_right, mid->element_);
+      }
+    } catch (...) {
+      Release_(right);
+      throw;
+    }
+    Release_(right);
+    return res;
+  }
+  return NewNode_(left, right, std::forward<Args>(args)...);
+}
+
+// Returns a new reference to the subtree with key inserted. A subtree that
+// comes back unchanged is the old one, so the path above it is not copied.
+template <typename K, typename V, typename C, typename A>
+template <typename... Args>
+const typename PersistentTree<K, V, C, A>::Node_ *
+PersistentTree<K, V, C, A>::InsertInto_(const Node_ *node, const K &key,
+                                        bool assign, bool &inserted,
+                                        Args &&...args) {
+  if (!node) {
+    const Node_ *leaf = NewNode_(nullptr, nullptr, std::forward<Args>(args)...);
+    inserted = true;
+    return leaf;
+  }
+  if (comp_(key, Key_(node))) {
+    const Node_ *left = InsertInto_(node->left_, key, assign, inserted,
+                                    std::forward<Args>(args)...);
+    if (left == node->left_) {
+      Release_(left);
+      return Retain_(node);
+    }
+    return Balance_(left, Retain_(node->right_), node->element_);
+  }
+  if (comp_(Key_(node), key)) {
+    const Node_ *right = InsertInto_(node->right_, key, assign, inserted,
+                                     std::forward<Args>(args)...);
+    if (right == node->right_) {
+      Release_(right);
+      return Retain_(node);
+    }
+    return Balance_(Retain_(node->left_), right, node->element_);
+  }
+  if (!assign) return Retain_(node);
+  return NewNode_(Retain_(node->left_), Retain_(node->right_),
+                  std::forward<Args>(args)...);
+}
+
+template <typename K, typename V, typename C, typename A>
+const typename PersistentTree<K, V, C, A>::Node_ *
+PersistentTree<K, V, C, A>::EraseFrom_(const Node_ *node, const K &key) {
+  if (!node) return nullptr;
+  if (comp_(key, Key_(node))) {
+    const Node_ *left = EraseFrom_(node->left_, key);
+    if (left == node->left_) {
+      Release_(left);
+      return Retain_(node);
+    }
+    return Balance_(left, Retain_(node->right_), node->element_);
+  }
+  if (comp_(Key_(node), key)) {
+    const Node_ *right = EraseFrom_(node->right_, key);
+    if (right == node->right_) {
+      Release_(right);
+      return Retain_(node);
+    }
+    return Balance_(Retain_(node->left_), right, node->element_);
+  }
+  // The smallest element of the right subtree takes the place of node.
+  const Node_ *res;
+  if (!node->left_) {
+    res = Retain_(node->right_);
+  } else if (!node->right_) {
+    res = Retain_(node->left_);
+  } else {
+    const Node_ *next = node->right_;
+    while (next->left_) next = next->left_;
+    const Node_ *right = EraseMin_(node->right_);
+    res = Balance_(Retain_(node->left_), right, next->element_);
+  }
+  --size_;
+  return res;
+}
+
+template <typename K, typename V, typename C, typename A>
+const typename PersistentTree<K, V, C, A>::Node_ *
+PersistentTree<K, V, C, A>::EraseMin_(const Node_ *node) {
+  if (!node->left_) return Retain_(node->right_);
+  const Node_ *left = EraseMin_(node->left_);
+  return Balance_(left, Retain_(node->right_), node->element_);
+}
+}  // namespace s21
+
+#endif  // S21_PERSISTENT_TREE_H_
@@ -0,0 +1,266 @@
+#ifndef S21_RCU_MAP_H_
+#define S21_RCU_MAP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "s21_map.h"
+
+namespace s21 {
+// Read-copy-update wrapper around s21::map for read-mostly data. Readers see
+// an immutable version of the map and never lock: a read announces the
+// current epoch in a slot of its own, loads the version pointer and clears
+// the slot when done. That announcement is the only atomic store on the
+// read path, and no two readers write the same cache line.
+//
+// A writer copies the current version, changes the copy and publishes it,
+// so an update costs a full copy and should batch its changes. Publishing
+// advances the epoch and retires the old version, which is freed once every
+// reader slot is idle or announces a later epoch: no reader can still hold
+// it. Writers are serialised by a mutex of their own and never wait for
+// readers, except in synchronize().
+//
+// Each reading thread takes a reader handle, which owns one slot, and reads
+// through it. A handle must not be shared between threads, and a read must
+// not start another read or an update on the same map.
+template <typename K, typename V, typename Compare = std::less<>,
+          typename Allocator = std::allocator<std::pair<const K, V>>>
+class rcu_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<const K, V>;
+  using size_type = size_t;
+  using map_type = map<K, V, Compare, Allocator>;
+
+ private:
+  // Epoch the reader started in, or 0 while it is not reading.
+  struct alignas(64) Slot_ {
+    std::atomic<std::uint64_t> epoch_{0};
+    bool used_ = false;
+  };
+
+ public:
+  class reader {
+   public:
+    explicit reader(rcu_map &owner) : owner_(owner), slot_(owner.Claim_()) {}
+    reader(const reader &other) = delete;
+    reader &operator=(const reader &other) = delete;
+    ~reader() { owner_.Free_(slot_); }
+
+    // Calls f with the current version and returns its result. The version
+    // stays alive until f returns; references into it must not escape.
+    template <typename F>
+    decltype(auto) read(F &&f);
+    std::optional<V> find(const K &key);
+    bool contains(const K &key);
+
+   private:
+    rcu_map &owner_;
+    Slot_ *slot_;
+  };
+
+  // CONSTRUCTORS
+  rcu_map() : rcu_map(map_type()) {}
+  explicit rcu_map(map_type initial);
+  rcu_map(const rcu_map &other) = delete;
+
+  // DESTRUCTOR
+  // Every reader handle must be gone by now.
+  ~rcu_map();
+
+  // OVERLOAD OPERATORS
+  rcu_map &operator=(const rcu_map &other) = delete;
+
+  // WRITERS
+  // update calls f with a copy of the current version and publishes the
+  // copy when f returns; if f throws, nothing is published. store publishes
+  // value as it is.
+  template <typename F>
+  void update(F &&f);
+  void store(map_type value);
+  bool insert(const K &key, const V &obj);
+  bool insert_or_assign(const K &key, const V &obj);
+  size_type erase(const K &key);
+
+  // Waits until every retired version has been freed, which takes as long
+  // as the longest read already running. Returns at once with no readers.
+  void synchronize();
+  // Retired versions still waiting for their grace period.
+  size_type retired() const;
+
+ private:
+  Slot_ *Claim_();
+  void Free_(Slot_ *slot);
+  void Publish_(map_type *next);
+  void Reclaim_();
+
+  std::atomic<const map_type *> current_;
+  std::atomic<std::uint64_t> epoch_;
+  // Writers hold writer_mutex_; slots_mutex_ guards the slot list, which a
+  // reader only touches when its handle is made or destroyed.
+  mutable std::mutex writer_mutex_;
+  mutable std::mutex slots_mutex_;
+  std::vector<std::unique_ptr<Slot_>> slots_;
+  // A version retired at epoch e may still be read by readers that
+  // announced an epoch before e.
+  std::vector<std::pair<const map_type *, std::uint64_t>> retired_;
+};
+
+template <typename K, typename V, typename C, typename A>
+rcu_map<K, V, C, A>::rcu_map(map_type initial)
+    : current_(new map_type(std::move(initial))), epoch_(1) {}
+
+template <typename K, typename V, typename C, typename A>
+rcu_map<K, V, C, A>::~rcu_map() {
+  for (auto &entry : retired_) delete entry.first;
+  delete current_.load(std::memory_order_relaxed);
+}
+
+// The announcement and the load of the version are sequentially consistent,
+// as are the writer's exchange of the version and its scan of the slots. A
+// writer that finds this slot idle or ahead of the retiring epoch therefore
+// knows the load below sees the new version.
+template <typename K, typename V, typename C, typename A>
+template <typename F>
+decltype(auto) rcu_map<K, V, C, A>::reader::read(F &&f) {
+  struct Leave_ {
+    Slot_ *slot;
+    ~Leave_() { slot->epoch_.store(0, std::memory_order_release); }
+  };
+  slot_->epoch_.store(owner_.epoch_.load(std::memory_order_seq_cst),
+                      std::memory_order_seq_cst);
+  Leave_ leave{slot_};
+  const map_type *version = owner_.current_.load(std::memory_order_seq_cst);
+  return std::forward<F>(f)(*version);
+}
+
+template <typename K, typename V, typename C, typename A>
+std::optional<V> rcu_map<K, V, C, A>::reader::find(const K &key) {
+  return read([&key](const map_type &version) -> std::optional<V> {
+    auto it = version.find(key);
+    if (it == version.end()) return std::nullopt;
+    return it->second;
+  });
+}
+
+template <typename K, typename V, typename C, typename A>
+bool rcu_map<K, V, C, A>::reader::contains(const K &key) {
+  return read(
+      [&key](const map_type &version) { return version.contains(key); });
+}
+
+template <typename K, typename V, typename C, typename A>
+template <typename F>
+void rcu_map<K, V, C, A>::update(F &&f) {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  auto next = std::make_unique<map_type>(
+      *current_.load(std::memory_order_relaxed));
+  std::forward<F>(f)(*next);
+  Publish_(next.release());
+}
+
+template <typename K, typename V, typename C, typename A>
+void rcu_map<K, V, C, A>::store(map_type value) {
+  auto next = std::make_unique<map_type>(std::move(value));
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  Publish_(next.release());
+}
+
+template <typename K, typename V, typename C, typename A>
+bool rcu_map<K, V, C, A>::insert(const K &key, const V &obj) {
+  bool inserted = false;
+  update([&](map_type &next) { inserted = next.insert(key, obj).second; });
+  return inserted;
+}
+
+template <typename K, typename V, typename C, typename A>
+bool rcu_map<K, V, C, A>::insert_or_assign(const K &key, const V &obj) {
+  bool inserted = false;
+  update([&](map_type &next) {
+    inserted = next.insert_or_assign(key, obj).second;
+  });
+  return inserted;
+}
+
+template <typename K, typename V, typename C, typename A>
+typename rcu_map<K, V, C, A>::size_type rcu_map<K, V, C, A>::erase(
+    const K &key) {
+  size_type erased = 0;
+  update([&](map_type &next) { erased = next.erase(key); });
+  return erased;
+}
+
+template <typename K, typename V, typename C, typename A>
+void rcu_map<K, V, C, A>::synchronize() {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  for (Reclaim_(); !retired_.empty(); Reclaim_()) std::this_thread::yield();
+}
+
+template <typename K, typename V, typename C, typename A>
+typename rcu_map<K, V, C, A>::size_type rcu_map<K, V, C, A>::retired()
+    const {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  return retired_.size();
+}
+
+template <typename K, typename V, typename C, typename A>
+typename rcu_map<K, V, C, A>::Slot_ *rcu_map<K, V, C, A>::Claim_() {
+  std::lock_guard<std::mutex> lock(slots_mutex_);
+  for (auto &slot : slots_) {
+    if (!slot->used_) {
+      slot->used_ = true;
+      return slot.get();
+    }
+  }
+  slots_.push_back(std::make_unique<Slot_>());
+  slots_.back()->used_ = true;
+  return slots_.back().get();
+}
+
+template <typename K, typename V, typename C, typename A>
+void rcu_map<K, V, C, A>::Free_(Slot_ *slot) {
+  std::lock_guard<std::mutex> lock(slots_mutex_);
+  slot->used_ = false;
+}
+
+template <typename K, typename V, typename C, typename A>
+void rcu_map<K, V, C, A>::Publish_(map_type *next) {
+  const map_type *old = current_.exchange(next, std::memory_order_seq_cst);
+  std::uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+  retired_.emplace_back(old, epoch);
+  Reclaim_();
+}
+
+// Frees the versions retired at or before the oldest epoch a reader has
+// announced.
+template <typename K, typename V, typename C, typename A>
+void rcu_map<K, V, C, A>::Reclaim_() {
+  std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+  {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    for (auto &slot : slots_) {
+      std::uint64_t epoch = slot->epoch_.load(std::memory_order_seq_cst);
+      if (epoch && epoch < oldest) oldest = epoch;
+    }
+  }
+  size_type kept = 0;
+  for (auto &entry : retired_) {
+    if (entry.second <= oldest)
+      delete entry.first;
+    else
+      retired_[kept++] = entry;
+  }
+  retired_.resize(kept);
+}
+}  // namespace s21
+
+#endif  // S21_RCU_MAP_H_
@@ -1,9 +1,15 @@
+#ifndef S21_SET_H_
+#define S21_SET_H_
+
 #include "s21_binary_tree.h"
 
 namespace s21 {
-template <typename K>
+// Ranked is the R flag of Tree, on by default; see there.
+template <typename K, typename Compare = std::less<>,
+          typename Allocator = std::allocator<K>, bool Ranked = true>
+class set : public Tree<K, KeyOnly, Compare, Allocator, Ranked> {
+  using Tree_ = Tree<K, KeyOnly, Compare, Allocator, Ranked>;
 
-class set : public Tree<K, K> {
  public:
   using key_type = K;
   using value_type = K;
@@ -11,116 +17,105 @@ class set : public Tree<K, K> {
   using const_reference = const K &;
   using size_type = size_t;
 
-  using Tree<K, K>::insert;
-
-  set() : Tree<K, K>() {}
-  set(std::initializer_list<value_type> const &items) {
-    for (value_type i : items) insert(i);
-  };
-  set(const set &s) : Tree<K, K>(s) {};
-  set(set &&s) noexcept : Tree<K, K>(std::move(s)) {};
+  // Keys are immutable through set iterators, so both aliases are const.
+  using iterator = typename Tree_::ConstIterator;
+  using const_iterator = iterator;
+  using node_type = typename Tree_::node_type;
+  using insert_return_type = typename Tree_::template InsertReturn<iterator>;
+
+  set() : Tree_() {}
+  explicit set(const Allocator &alloc) : Tree_(alloc) {}
+  explicit set(const Compare &comp, const Allocator &alloc = Allocator())
+      : Tree_(comp, alloc) {}
+  set(std::initializer_list<value_type> const &items) : Tree_(items) {};
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  set(InputIt first, InputIt last) : Tree_(first, last) {}
+  set(const set &s) : Tree_(s) {};
+  set(set &&s) noexcept : Tree_(std::move(s)) {};
   ~set() = default;
 
+  set &operator=(const set &s) {
+    Tree_::operator=(s);
+    return *this;
+  }
   set &operator=(set &&s) noexcept {
-    Tree<K, K>::operator=(std::move(s));
+    Tree_::operator=(std::move(s));
     return *this;
   }
 
- protected:
-  class ConstSetIterator : public Tree<K, K>::ConstIterator {
-   public:
-    ConstSetIterator() noexcept : Tree<K, K>::ConstIterator() {}
-    ConstSetIterator(const ConstSetIterator &other)
-        : Tree<K, K>::ConstIterator(other) {}
-    explicit ConstSetIterator(Tree<K, K> *tree) noexcept
-        : Tree<K, K>::ConstIterator(tree) {}
-    explicit ConstSetIterator(typename Tree<K, K>::ConstIterator &other) {
-      Tree<K, K> *tr = other.GetTree();
-      this->tree_ = tr;
-    }
-
-    ~ConstSetIterator() = default;
-
-    ConstSetIterator &operator=(const ConstSetIterator &other) {
-      ConstSetIterator tmp(other);
-      this->tree_ = tmp.GetTree();
-      return *this;
-    }
-
-    const_reference operator*() {
-      typename Tree<K, K>::Node_ *rt = this->GetNode();
-      return rt->element_.first;
-    }
-    const value_type *operator->() {}
-  };
-
-  class SetIterator : public ConstSetIterator {
-   public:
-    SetIterator() noexcept : ConstSetIterator() {}
-    SetIterator(const SetIterator &other) : ConstSetIterator(other) {}
-    explicit SetIterator(Tree<K, K> *tree) noexcept : ConstSetIterator(tree) {}
-    explicit SetIterator(typename Tree<K, K>::Iterator &other) {
-      Tree<K, K> *tr = other.GetTree();
-      this->tree_ = tr;
-    }
-
-    ~SetIterator() = default;
-
-    SetIterator &operator=(const SetIterator &other) {
-      ConstSetIterator::operator=(other);
-      return *this;
-    }
-  };
-
- public:
-  using const_iterator = ConstSetIterator;
-  using iterator = SetIterator;
-
-  virtual std::pair<iterator, bool> insert(const value_type &value) {
-    std::pair<key_type, value_type> tmp_el{value, value};
-    typename Tree<K, K>::iterator tree_it;
-    bool is_inserted = false;
-    std::pair<K, K> val{value, value};
-    this->Insert_(val, tree_it, is_inserted);
-    SetIterator set_it(tree_it);
-    std::pair<SetIterator, bool> res{set_it, is_inserted};
-    return res;
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return Tree_::insert(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return Tree_::insert(std::move(value));
+  }
+  iterator insert(const_iterator hint, const value_type &value) {
+    return Tree_::insert(hint, value);
+  }
+  iterator insert(const_iterator hint, value_type &&value) {
+    return Tree_::insert(hint, std::move(value));
+  }
+  insert_return_type insert(node_type &&node) {
+    auto res = this->InsertNode_(node, true);
+    return {res.first, res.second, std::move(node)};
+  }
+  iterator insert(const_iterator hint, node_type &&node) {
+    return this->HintInsertNode_(hint, node, true);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return Tree_::emplace(std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return Tree_::emplace_hint(hint, std::forward<Args>(args)...);
   }
 
-  
-
-  iterator begin() const {
-    if (!this->left_ && !this->right_ && !this->root_)
-      throw std::out_of_range("Tree does not exist");
-    const Tree<K, K> *tmp_this = this;
-    Tree<K, K> *min_tr = this->FindMin(this->left_ ? this->left_ : tmp_this);
-    return SetIterator(min_tr);
-  }
-  iterator end() const {
-    if (!this->left_ && !this->right_ && !this->root_)
-      throw std::out_of_range("Tree does not exist");
-    const Tree<K, K> *tmp_this = this;
-    Tree<K, K> *max_tr = this->FindMax(this->right_ ? this->right_ : tmp_this);
-    return SetIterator(max_tr);
-  }
-  iterator find(const K &key) const {
-    if (!this->contains(key)) throw std::out_of_range("Key does not exist");
-    auto it = begin();
-    for (; *it != key; ++it);
-    return it;
+  iterator begin() const noexcept { return Tree_::begin(); }
+  iterator end() const noexcept { return Tree_::end(); }
+  template <typename T = K>
+  iterator find(const T &key) const {
+    return Tree_::find(key);
   }
+  template <typename T = K>
+  iterator lower_bound(const T &key) const {
+    return Tree_::lower_bound(key);
+  }
+  template <typename T = K>
+  iterator upper_bound(const T &key) const {
+    return Tree_::upper_bound(key);
+  }
+  template <typename T = K>
+  std::pair<iterator, iterator> equal_range(const T &key) const {
+    return Tree_::equal_range(key);
+  }
+  iterator nth(size_type k) const { return Tree_::nth(k); }
   void erase(iterator pos) {
-    typename Tree<K, K>::Iterator it;
-    it.SetTree(pos.GetTree());
-    Tree<K, K>::erase(it);
+    Tree_::erase(typename Tree_::Iterator(pos.GetNode(), this));
+  }
+  iterator erase(const_iterator first, const_iterator last) {
+    return Tree_::erase(first, last);
+  }
+  template <typename T = K>
+  size_type erase_range(const T &lo, const T &hi) {
+    return Tree_::erase_range(lo, hi);
+  }
+  template <typename T = K>
+  set extract_range(const T &lo, const T &hi) {
+    set res(this->key_comp(), this->get_allocator());
+    this->ExtractKeys_(lo, hi, res);
+    return res;
   }
 
   template <typename... Args>
-  std::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
     std::vector<std::pair<iterator, bool>> res_set_vec;
-    for (auto el : {std::forward<Args>(args)...})
-      res_set_vec.push_back(set<K>::insert(el));
+    res_set_vec.reserve(sizeof...(args));
+    (res_set_vec.push_back(set::insert(std::forward<Args>(args))), ...);
     return res_set_vec;
   }
 };
 }  // namespace s21
+
+#endif  // S21_SET_H_
@@ -0,0 +1,84 @@
+#ifndef S21_UNORDERED_MAP_H_
+#define S21_UNORDERED_MAP_H_
+
+#include "s21_hash_table.h"
+
+namespace s21 {
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class unordered_map : public HashTable<K, V, Hash, KeyEqual> {
+  using Table_ = HashTable<K, V, Hash, KeyEqual>;
+
+ public:
+  using typename Table_::value_type;
+  using typename Table_::size_type;
+  using typename Table_::iterator;
+
+  // CONSTRUCTORS
+  unordered_map() : Table_() {}
+  explicit unordered_map(size_type bucket_count, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual())
+      : Table_(bucket_count, hash, equal) {}
+  unordered_map(std::initializer_list<value_type> const &items)
+      : Table_(items) {}
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  unordered_map(InputIt first, InputIt last) : Table_(first, last) {}
+  unordered_map(const unordered_map &m) : Table_(m) {}
+  unordered_map(unordered_map &&m) noexcept : Table_(std::move(m)) {}
+
+  // DESTRUCTOR
+  ~unordered_map() = default;
+
+  // OVERLOAD OPERATORS
+  unordered_map &operator=(const unordered_map &m) {
+    Table_::operator=(m);
+    return *this;
+  }
+  unordered_map &operator=(unordered_map &&m) noexcept {
+    Table_::operator=(std::move(m));
+    return *this;
+  }
+
+  V &operator[](const K &key) { return try_emplace(key).first->second; }
+
+  // BASIC METHODS
+  using Table_::erase;
+  using Table_::insert;
+
+  V &at(const K &key) { return AtOrThrow_(key)->second; }
+  const V &at(const K &key) const { return AtOrThrow_(key)->second; }
+  size_type count(const K &key) const { return this->contains(key) ? 1 : 0; }
+  std::pair<iterator, bool> insert(const K &key, const V &obj) {
+    return try_emplace(key, obj);
+  }
+  std::pair<iterator, bool> insert_or_assign(const K &key, const V &obj) {
+    std::pair<iterator, bool> res_it = try_emplace(key, obj);
+    if (!res_it.second) res_it.first->second = obj;
+    return res_it;
+  }
+  // Constructs the mapped value from args only if key is absent; otherwise
+  // neither key nor args are touched.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K &key, Args &&...args) {
+    return this->EmplaceKey_(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(K &&key, Args &&...args) {
+    return this->EmplaceKey_(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+ private:
+  iterator AtOrThrow_(const K &key) const {
+    iterator it = this->Find_(key);
+    if (it == this->end()) throw std::out_of_range("Key does not exist");
+    return it;
+  }
+};
+}  // namespace s21
+
+#endif  // S21_UNORDERED_MAP_H_
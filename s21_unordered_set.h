@@ -0,0 +1,66 @@
+#ifndef S21_UNORDERED_SET_H_
+#define S21_UNORDERED_SET_H_
+
+#include "s21_hash_table.h"
+
+namespace s21 {
+template <typename K, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class unordered_set : public HashTable<K, KeyOnly, Hash, KeyEqual> {
+  using Table_ = HashTable<K, KeyOnly, Hash, KeyEqual>;
+
+ public:
+  using key_type = K;
+  using value_type = K;
+  using reference = K &;
+  using const_reference = const K &;
+  using size_type = size_t;
+
+  // Keys are immutable through set iterators, so both aliases are const.
+  using iterator = typename Table_::ConstIterator;
+  using const_iterator = iterator;
+
+  unordered_set() : Table_() {}
+  explicit unordered_set(size_type bucket_count, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual())
+      : Table_(bucket_count, hash, equal) {}
+  unordered_set(std::initializer_list<value_type> const &items)
+      : Table_(items) {}
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  unordered_set(InputIt first, InputIt last) : Table_(first, last) {}
+  unordered_set(const unordered_set &s) : Table_(s) {}
+  unordered_set(unordered_set &&s) noexcept : Table_(std::move(s)) {}
+  ~unordered_set() = default;
+
+  unordered_set &operator=(const unordered_set &s) {
+    Table_::operator=(s);
+    return *this;
+  }
+  unordered_set &operator=(unordered_set &&s) noexcept {
+    Table_::operator=(std::move(s));
+    return *this;
+  }
+
+  using Table_::insert;
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return Table_::insert(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return Table_::insert(std::move(value));
+  }
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    auto res_vec = Table_::insert_many(std::forward<Args>(args)...);
+    return std::vector<std::pair<iterator, bool>>(res_vec.begin(),
+                                                  res_vec.end());
+  }
+
+  iterator begin() const noexcept { return Table_::begin(); }
+  iterator end() const noexcept { return Table_::end(); }
+  iterator find(const K &key) const { return Table_::find(key); }
+  size_type count(const K &key) const { return this->contains(key) ? 1 : 0; }
+};
+}  // namespace s21
+
+#endif  // S21_UNORDERED_SET_H_
@@ -1,4 +1,9 @@
+#ifndef S21_VECTOR_H_
+#define S21_VECTOR_H_
+
+#include <algorithm>
 #include <iostream>
+#include <utility>
 
 namespace s21 {
 template <typename T>
@@ -26,6 +31,8 @@ class vector {
   ~vector();                    // деструктор
   s21::vector<T>& operator=(
       s21::vector<T>&& other);  // Оператор присваивания перемещения
+  s21::vector<T>& operator=(
+      const s21::vector<T>& other);  // Оператор присваивания копирования
   // vector& operator=(
   //     vector&& other);
   reference at(
@@ -36,8 +43,10 @@ class vector {
   iterator data() noexcept;  // возвращает указатель на данные массива
   iterator begin();  // возвращает указатель на начало вектора
   iterator end();  // возвращает указатель на следующий после конце элемент
+  const_iterator begin() const;  // то же для константного вектора
+  const_iterator end() const;    // то же для константного вектора
   bool empty() const noexcept;  // ture - если вктор пуст, иначе false
-  size_type size();             // гетер размера вектора
+  size_type size() const;       // гетер размера вектора
   void reserve(size_type size);  // зарезервировать больше памяти
   size_type capacity();  // гетер вместимости вектора
   void shrink_to_fit();  // уменьшение разера (очистка не используемой памяти)
@@ -49,6 +58,7 @@ class vector {
   iterator erase(iterator pos);  // удаляет элемент,по указанной позиции и
                                  // возвращает указатель на эту позицию
   void push_back(const_reference value);  // добавляет элемент в конец вектора
+  void push_back(value_type&& value);  // то же, перемещая элемент
   void pop_back();  // удаляет последний элемент из вектора
   void swap(vector& other) noexcept;  // обмен значениями с другим вектором
 };
@@ -97,6 +107,15 @@ s21::vector<T>& s21::vector<T>::operator=(s21::vector<T>&& other) {
   }
   return *this;
 }
+// Оператор присваивания копирования
+template <typename T>
+s21::vector<T>& s21::vector<T>::operator=(const s21::vector<T>& other) {
+  if (this != &other) {
+    vector<T> copy(other);
+    this->swap(copy);
+  }
+  return *this;
+}
 
 // возвращает ссылку на указанный элемент по индексу
 template <typename T>
@@ -142,6 +161,14 @@ template <typename T>
 typename vector<T>::iterator vector<T>::end() {
   return arr + m_size;
 }
+template <typename T>
+typename vector<T>::const_iterator vector<T>::begin() const {
+  return arr;
+}
+template <typename T>
+typename vector<T>::const_iterator vector<T>::end() const {
+  return arr + m_size;
+}
 // ture - если вктор пуст, иначе false
 
 template <typename T>
@@ -150,7 +177,7 @@ bool vector<T>::empty() const noexcept {
 }
 // гетер размера вектора
 template <typename T>
-typename vector<T>::size_type vector<T>::size() {
+typename vector<T>::size_type vector<T>::size() const {
   return m_size;
 }
 // зарезервировать больше памяти
@@ -161,7 +188,7 @@ void vector<T>::reserve(size_type size) {
   T* temp = new T[m_capacity];
   if (arr != nullptr) {
     for (size_type i = 0; i < m_size; i++) {
-      temp[i] = arr[i];
+      temp[i] = std::move(arr[i]);
     }
     delete[] arr;
   }
@@ -189,6 +216,7 @@ void vector<T>::shrink_to_fit() {
 template <typename T>
 void vector<T>::clear() {
   delete[] arr;
+  arr = nullptr;
   m_size = 0;
   m_capacity = 0;
 }
@@ -201,9 +229,9 @@ T* vector<T>::insert(const_iterator pos, const_reference value) {
   }
   size_t index = pos - arr;
   if (m_size == m_capacity) {
-    reserve(m_size + 1);
+    reserve(m_capacity ? m_capacity * 2 : 1);  // рост вдвое
   }
-  std::copy_backward(arr + index, arr + m_size, arr + m_size + 1);
+  std::move_backward(arr + index, arr + m_size, arr + m_size + 1);
   arr[index] = value;
   ++m_size;
   return arr + index;
@@ -216,7 +244,7 @@ T* vector<T>::erase(iterator pos) {
     throw std::out_of_range("Position out of range");
   }
   size_t index = pos - arr;
-  std::copy(arr + index + 1, arr + m_size, arr + index);
+  std::move(arr + index + 1, arr + m_size, arr + index);
   --m_size;
   return arr + index;
 }
@@ -224,10 +252,18 @@ T* vector<T>::erase(iterator pos) {
 template <typename T>
 void vector<T>::push_back(const_reference value) {
   if (m_size == m_capacity) {
-    reserve(m_size + 1);
+    reserve(m_capacity ? m_capacity * 2 : 1);
   }
   arr[m_size++] = value;
 }
+// добавляет элемент в конец вектора, перемещая его
+template <typename T>
+void vector<T>::push_back(value_type&& value) {
+  if (m_size == m_capacity) {
+    reserve(m_capacity ? m_capacity * 2 : 1);
+  }
+  arr[m_size++] = std::move(value);
+}
 // удаляет последний элемент из вектора
 template <typename T>
 void vector<T>::pop_back() {
@@ -244,3 +280,5 @@ void vector<T>::swap(vector& other) noexcept {
   std::swap(arr, other.arr);
 }
 }  // namespace s21
+
+#endif  // S21_VECTOR_H_
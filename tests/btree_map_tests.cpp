@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+
+#include "../s21_btree_map.h"
+
+TEST(btree_map_constructor, case1) {
+  s21::btree_map<int, std::string> s21_map;
+  EXPECT_TRUE(s21_map.empty());
+  EXPECT_TRUE(s21_map.begin() == s21_map.end());
+
+  s21::btree_map<int, std::string> s21_map_list = {
+      {3, "c"}, {1, "a"}, {2, "b"}, {1, "duplicate"}};
+  EXPECT_EQ(s21_map_list.size(), 3U);
+  EXPECT_EQ(s21_map_list.at(1), "a");
+
+  s21::btree_map<int, std::string> s21_map_copy(s21_map_list);
+  s21::btree_map<int, std::string> s21_map_moved(std::move(s21_map_list));
+  EXPECT_EQ(s21_map_copy.size(), 3U);
+  EXPECT_EQ(s21_map_moved.size(), 3U);
+  EXPECT_TRUE(s21_map_list.empty());
+}
+
+TEST(btree_map_insert, case1) {
+  s21::btree_map<int, int> s21_map;
+  std::map<int, int> std_map;
+  for (int i = 0; i < 10000; ++i) {
+    int key = (i * 7919) % 10007;
+    s21_map.insert(key, i);
+    std_map.insert({key, i});
+  }
+  EXPECT_FALSE(s21_map.insert(0, 1).second);
+  ASSERT_EQ(s21_map.size(), std_map.size());
+
+  auto it = s21_map.begin();
+  for (const auto &item : std_map) {
+    EXPECT_EQ(it->first, item.first);
+    EXPECT_EQ(it->second, item.second);
+    ++it;
+  }
+  EXPECT_TRUE(it == s21_map.end());
+}
+
+TEST(btree_map_erase, case1) {
+  s21::btree_map<int, int> s21_map;
+  for (int i = 0; i < 5000; ++i) s21_map.insert(i, i);
+  for (int i = 0; i < 5000; i += 3) EXPECT_EQ(s21_map.erase(i), 1U);
+  EXPECT_EQ(s21_map.erase(0), 0U);
+  EXPECT_EQ(s21_map.size(), 3333U);
+  EXPECT_FALSE(s21_map.contains(3));
+  EXPECT_TRUE(s21_map.contains(4));
+
+  while (!s21_map.empty()) s21_map.erase(s21_map.begin());
+  EXPECT_TRUE(s21_map.begin() == s21_map.end());
+}
+
+TEST(btree_map_at, case1) {
+  s21::btree_map<std::string, int> s21_map = {{"one", 1}, {"two", 2}};
+  s21_map["three"] = 3;
+  s21_map["one"] += 10;
+  s21_map.insert_or_assign("two", 22);
+
+  EXPECT_EQ(s21_map.at("one"), 11);
+  EXPECT_EQ(s21_map.at("two"), 22);
+  EXPECT_EQ(s21_map.count("three"), 1U);
+  EXPECT_THROW(s21_map.at("four"), std::out_of_range);
+}
+
+TEST(btree_map_bounds, case1) {
+  s21::btree_map<int, int> s21_map;
+  for (int i = 0; i < 1000; i += 10) s21_map.insert(i, i);
+
+  EXPECT_EQ(s21_map.lower_bound(35)->first, 40);
+  EXPECT_EQ(s21_map.upper_bound(40)->first, 50);
+  EXPECT_TRUE(s21_map.lower_bound(991) == s21_map.end());
+  EXPECT_TRUE(s21_map.find(35) == s21_map.end());
+
+  auto range = s21_map.equal_range(500);
+  EXPECT_EQ(range.first->first, 500);
+  EXPECT_EQ(range.second->first, 510);
+  EXPECT_EQ((--s21_map.end())->first, 990);
+}
+
+TEST(btree_map_merge, case1) {
+  s21::btree_map<int, int> s21_map = {{1, 1}, {2, 2}};
+  s21::btree_map<int, int> s21_map_other = {{2, 20}, {3, 30}};
+  s21_map.merge(s21_map_other);
+
+  EXPECT_EQ(s21_map.size(), 3U);
+  EXPECT_EQ(s21_map.at(2), 2);
+  EXPECT_TRUE(s21_map_other.empty());
+
+  s21_map.swap(s21_map_other);
+  EXPECT_TRUE(s21_map.empty());
+  EXPECT_EQ(s21_map_other.size(), 3U);
+}
+
+TEST(btree_map_emplace, case1) {
+  s21::btree_map<int, std::unique_ptr<int>> s21_map;
+  auto res = s21_map.try_emplace(1, new int(10));
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(*res.first->second, 10);
+
+  std::unique_ptr<int> value(new int(20));
+  res = s21_map.try_emplace(1, std::move(value));
+  EXPECT_FALSE(res.second);
+  EXPECT_NE(value, nullptr);
+  EXPECT_EQ(*s21_map[1], 10);
+}
+
+// Orders by remainder first, so the order depends on state in the comparator.
+struct ByRemainder {
+  int mod;
+  bool operator()(int a, int b) const {
+    return a % mod != b % mod ? a % mod < b % mod : a < b;
+  }
+};
+
+TEST(btree_map_comparator, case1) {
+  s21::btree_map<int, int, ByRemainder> s21_map(ByRemainder{7});
+  std::map<int, int, ByRemainder> std_map(ByRemainder{7});
+  for (int i = 0; i < 3000; ++i) {
+    int key = (i * 37) % 2000;
+    EXPECT_EQ(s21_map.insert(key, i).second, std_map.insert({key, i}).second);
+  }
+  for (int i = 0; i < 2000; i += 3)
+    EXPECT_EQ(s21_map.erase(i), std_map.erase(i));
+
+  s21::btree_map<int, int, ByRemainder> s21_map_copy(s21_map);
+  EXPECT_EQ(s21_map_copy.key_comp().mod, 7);
+  ASSERT_EQ(s21_map_copy.size(), std_map.size());
+  EXPECT_TRUE(std::equal(std_map.begin(), std_map.end(), s21_map_copy.begin()));
+  EXPECT_EQ(s21_map.lower_bound(8)->first, std_map.lower_bound(8)->first);
+  EXPECT_EQ(s21_map.upper_bound(1)->first, std_map.upper_bound(1)->first);
+  EXPECT_EQ(s21_map.find(3), s21_map.end());
+  EXPECT_EQ(s21_map.find(1)->first, 1);
+  EXPECT_EQ(s21_map.at(1999), std_map.at(1999));
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <set>
+
+#include "../s21_allocator.h"
+#include "../s21_btree_set.h"
+
+TEST(btree_set_constructor, case1) {
+  std::vector<std::string> words = {"delta", "alpha", "charlie", "alpha"};
+  s21::btree_set<std::string> s21_set(words.begin(), words.end());
+
+  EXPECT_EQ(s21_set.size(), 3U);
+  EXPECT_EQ(*s21_set.begin(), "alpha");
+
+  s21::btree_set<std::string> s21_set_copy;
+  s21_set_copy = s21_set;
+  EXPECT_EQ(s21_set_copy.size(), 3U);
+  EXPECT_TRUE(s21_set_copy.contains("charlie"));
+}
+
+TEST(btree_set_insert, case1) {
+  s21::btree_set<std::string> s21_set;
+  std::set<std::string> std_set;
+  for (int i = 0; i < 3000; ++i) {
+    std::string key = std::to_string((i * 31) % 2000);
+    EXPECT_EQ(s21_set.insert(key).second, std_set.insert(key).second);
+  }
+  ASSERT_EQ(s21_set.size(), std_set.size());
+
+  auto it = s21_set.end();
+  for (auto std_it = std_set.rbegin(); std_it != std_set.rend(); ++std_it)
+    EXPECT_EQ(*--it, *std_it);
+  EXPECT_TRUE(it == s21_set.begin());
+}
+
+TEST(btree_set_erase, case1) {
+  s21::btree_set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 4000; ++i) {
+    s21_set.insert(i);
+    std_set.insert(i);
+  }
+  for (int i = 0; i < 4000; i += 2) {
+    int key = (i * 13) % 4000;
+    EXPECT_EQ(s21_set.erase(key), std_set.erase(key));
+  }
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  auto it = s21_set.begin();
+  for (int key : std_set) EXPECT_EQ(*it++, key);
+}
+
+TEST(btree_set_insert_many, case1) {
+  s21::btree_set<int> s21_set = {5};
+  auto res = s21_set.insert_many(1, 5, 9);
+
+  EXPECT_EQ(res.size(), 3U);
+  EXPECT_TRUE(res[0].second);
+  EXPECT_FALSE(res[1].second);
+  EXPECT_EQ(*res[2].first, 9);
+  EXPECT_EQ(*s21_set.upper_bound(5), 9);
+}
+
+TEST(btree_set_allocator, case1) {
+  using pool_set =
+      s21::btree_set<int, std::greater<>, s21::node_pool_allocator<int>>;
+  pool_set s21_set;
+  std::set<int, std::greater<>> std_set;
+  for (int i = 0; i < 4000; ++i) {
+    int key = (i * 13) % 3000;
+    EXPECT_EQ(s21_set.insert(key).second, std_set.insert(key).second);
+  }
+  for (int i = 0; i < 3000; i += 2)
+    EXPECT_EQ(s21_set.erase(i), std_set.erase(i));
+
+  pool_set s21_set_copy(s21_set);
+  ASSERT_EQ(s21_set_copy.size(), std_set.size());
+  EXPECT_TRUE(std::equal(std_set.begin(), std_set.end(), s21_set_copy.begin()));
+  EXPECT_EQ(*s21_set.begin(), 2999);
+  EXPECT_EQ(*s21_set.lower_bound(100), 99);
+  EXPECT_EQ(*s21_set.upper_bound(99), 97);
+}
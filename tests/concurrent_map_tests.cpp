@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_concurrent_map.h"
+
+TEST(concurrent_map_constructor, case1) {
+  s21::concurrent_map<int, std::string> s21_map = {{1, "a"}, {2, "b"}};
+  EXPECT_EQ(s21_map.size(), 2U);
+  EXPECT_EQ(s21_map.shard_count(), 64U);
+
+  s21::concurrent_map<int, int> s21_map_single(0);
+  EXPECT_EQ(s21_map_single.shard_count(), 1U);
+  EXPECT_TRUE(s21_map_single.empty());
+}
+
+// Orders ascending or descending as told, so each shard must get a copy.
+struct DirectedLess {
+  bool descending = false;
+  bool operator()(int a, int b) const { return descending ? b < a : a < b; }
+};
+
+TEST(concurrent_map_constructor, case2) {
+  using directed_map =
+      s21::concurrent_map<int, int, std::hash<int>, DirectedLess>;
+  directed_map s21_map(DirectedLess{true});
+  EXPECT_EQ(s21_map.shard_count(), directed_map::kDefaultShards);
+  EXPECT_TRUE(s21_map.key_comp().descending);
+  for (int i = 0; i < 1000; ++i) s21_map.insert(i, i);
+
+  std::vector<int> keys;
+  s21_map.for_each_ordered(
+      [&keys](const std::pair<const int, int> &elem) {
+        keys.push_back(elem.first);
+      });
+  ASSERT_EQ(keys.size(), 1000U);
+  EXPECT_TRUE(std::is_sorted(keys.rbegin(), keys.rend()));
+  EXPECT_EQ(s21_map.snapshot().begin()->first, 999);
+
+  directed_map s21_map_sharded(4, std::hash<int>(), DirectedLess{true},
+                               std::allocator<std::pair<const int, int>>());
+  EXPECT_EQ(s21_map_sharded.shard_count(), 4U);
+  s21_map_sharded.for_each_shard([](const directed_map::shard_type &shard) {
+    EXPECT_TRUE(shard.key_comp().descending);
+  });
+}
+
+TEST(concurrent_map_modifiers, case1) {
+  s21::concurrent_map<int, std::string> s21_map(8);
+  EXPECT_TRUE(s21_map.insert(1, "one"));
+  EXPECT_FALSE(s21_map.insert({1, "uno"}));
+  EXPECT_TRUE(s21_map.try_emplace(2, 3, 'x'));
+  EXPECT_FALSE(s21_map.insert_or_assign(1, "eins"));
+  EXPECT_EQ(*s21_map.find(1), "eins");
+  EXPECT_EQ(*s21_map.find(2), "xxx");
+  EXPECT_FALSE(s21_map.find(3).has_value());
+
+  EXPECT_TRUE(s21_map.visit(2, [](std::string &value) { value += "y"; }));
+  EXPECT_FALSE(s21_map.visit(3, [](std::string &) { FAIL(); }));
+  EXPECT_EQ(*s21_map.find(2), "xxxy");
+
+  EXPECT_EQ(s21_map.erase(1), 1U);
+  EXPECT_EQ(s21_map.erase(1), 0U);
+  EXPECT_FALSE(s21_map.contains(1));
+  s21_map.clear();
+  EXPECT_TRUE(s21_map.empty());
+}
+
+TEST(concurrent_map_scan, case1) {
+  s21::concurrent_map<int, int> s21_map(16);
+  std::map<int, int> std_map;
+  for (int i = 0; i < 1000; ++i) {
+    int key = (i * 7919) % 1000;
+    s21_map.insert(key, i);
+    std_map.insert({key, i});
+  }
+
+  std::vector<int> keys;
+  s21_map.for_each_ordered(
+      [&keys](const std::pair<const int, int> &elem) {
+        keys.push_back(elem.first);
+      });
+  ASSERT_EQ(keys.size(), 1000U);
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(keys[i], i);
+
+  auto snapshot = s21_map.snapshot();
+  EXPECT_EQ(snapshot.size(), std_map.size());
+  EXPECT_TRUE(std::equal(std_map.begin(), std_map.end(), snapshot.begin()));
+
+  size_t total = 0;
+  s21_map.for_each_shard(
+      [&total](const s21::map<int, int> &shard) { total += shard.size(); });
+  EXPECT_EQ(total, 1000U);
+}
+
+TEST(concurrent_map_threads, case1) {
+  s21::concurrent_map<int, int> s21_map(32);
+  const int threads = 8;
+  const int per_thread = 2000;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&s21_map, t] {
+      for (int i = 0; i < per_thread; ++i) {
+        int key = t * per_thread + i;
+        s21_map.insert(key, 0);
+        s21_map.visit(key % 100, [](int &value) { ++value; });
+        s21_map.find(key / 2);
+        if (i % 4 == 0) s21_map.erase(key);
+      }
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+
+  EXPECT_EQ(s21_map.size(), size_t(threads * per_thread * 3 / 4));
+  int previous = -1;
+  s21_map.for_each_ordered([&previous](const std::pair<const int, int> &elem) {
+    EXPECT_LT(previous, elem.first);
+    previous = elem.first;
+  });
+}
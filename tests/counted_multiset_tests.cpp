@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../s21_allocator.h"
+#include "../s21_counted_multiset.h"
+
+TEST(counted_multiset_constructor, case1) {
+  s21::counted_multiset<std::string> s21_multiset = {"b", "a", "b", "c", "b"};
+  EXPECT_EQ(s21_multiset.size(), 5U);
+  EXPECT_EQ(s21_multiset.distinct(), 3U);
+
+  std::string keys;
+  for (const auto &key : s21_multiset) keys += key;
+  EXPECT_EQ(keys, "abbbc");
+
+  s21::counted_multiset<std::string> s21_multiset_copy(s21_multiset);
+  s21::counted_multiset<std::string> s21_multiset_moved(
+      std::move(s21_multiset));
+  EXPECT_TRUE(s21_multiset.empty());
+  EXPECT_EQ(s21_multiset_copy.size(), 5U);
+  EXPECT_EQ(s21_multiset_moved.count("b"), 3U);
+}
+
+TEST(counted_multiset_insert, case1) {
+  s21::counted_multiset<int> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 5000; ++i) {
+    int key = (i * 37) % 101;
+    s21_multiset.insert(key);
+    std_multiset.insert(key);
+  }
+  auto it = s21_multiset.insert(7, 1000);
+  for (int i = 0; i < 1000; ++i) std_multiset.insert(7);
+  EXPECT_EQ(*it, 7);
+  EXPECT_EQ(++it, s21_multiset.upper_bound(7));
+
+  ASSERT_EQ(s21_multiset.size(), std_multiset.size());
+  EXPECT_EQ(s21_multiset.distinct(), 101U);
+  EXPECT_TRUE(std::equal(std_multiset.begin(), std_multiset.end(),
+                         s21_multiset.begin(), s21_multiset.end()));
+  EXPECT_TRUE(std::equal(std_multiset.rbegin(), std_multiset.rend(),
+                         std::make_reverse_iterator(s21_multiset.end())));
+}
+
+// Counts its copies, to see that a key already present is not copied.
+struct CopiedKey {
+  explicit CopiedKey(int value) : value(value) {}
+  CopiedKey(const CopiedKey &other) : value(other.value) { ++copies; }
+  bool operator<(const CopiedKey &other) const { return value < other.value; }
+  int value;
+  static int copies;
+};
+int CopiedKey::copies = 0;
+
+TEST(counted_multiset_insert, case2) {
+  s21::counted_multiset<CopiedKey> s21_multiset;
+  CopiedKey key(5);
+  CopiedKey::copies = 0;
+  s21_multiset.insert(key, 3);
+  EXPECT_EQ(CopiedKey::copies, 1);
+  s21_multiset.insert(key);
+  s21_multiset.insert(key, 2);
+  EXPECT_EQ(CopiedKey::copies, 1);
+  EXPECT_EQ(s21_multiset.count(key), 6U);
+  EXPECT_EQ(s21_multiset.distinct(), 1U);
+}
+
+TEST(counted_multiset_lookup, case1) {
+  s21::counted_multiset<int> s21_multiset;
+  s21_multiset.insert(3, 1000000);
+  s21_multiset.insert(1, 2);
+  s21_multiset.insert(5);
+
+  EXPECT_EQ(s21_multiset.size(), 1000003U);
+  EXPECT_EQ(s21_multiset.count(3), 1000000U);
+  EXPECT_EQ(s21_multiset.count(4), 0U);
+  EXPECT_TRUE(s21_multiset.contains(5));
+  EXPECT_EQ(s21_multiset.find(4), s21_multiset.end());
+
+  auto range = s21_multiset.equal_range(3);
+  EXPECT_EQ(*range.first, 3);
+  EXPECT_EQ(*std::prev(range.second), 3);
+  EXPECT_EQ(*range.second, 5);
+  EXPECT_EQ(*std::prev(range.first), 1);
+  EXPECT_EQ(s21_multiset.lower_bound(2), range.first);
+}
+
+TEST(counted_multiset_erase, case1) {
+  s21::counted_multiset<int> s21_multiset = {1, 2, 2, 2, 3};
+  s21_multiset.erase(s21_multiset.find(2));
+  EXPECT_EQ(s21_multiset.count(2), 2U);
+  EXPECT_EQ(s21_multiset.erase(2), 2U);
+  EXPECT_EQ(s21_multiset.erase(2), 0U);
+  s21_multiset.erase(s21_multiset.begin());
+  EXPECT_EQ(s21_multiset.size(), 1U);
+  EXPECT_EQ(s21_multiset.distinct(), 1U);
+  EXPECT_EQ(*s21_multiset.begin(), 3);
+
+  s21::counted_multiset<int> s21_multiset_other = {3, 4, 4};
+  s21_multiset.merge(s21_multiset_other);
+  EXPECT_TRUE(s21_multiset_other.empty());
+  EXPECT_EQ(s21_multiset.size(), 4U);
+  EXPECT_EQ(s21_multiset.count(3), 2U);
+}
+
+TEST(counted_multiset_allocator, case1) {
+  using pool_multiset =
+      s21::counted_multiset<int, std::less<>,
+                            s21::node_pool_allocator<int>>;
+  pool_multiset s21_multiset;
+  for (int i = 0; i < 10000; ++i) s21_multiset.insert(i % 50);
+  EXPECT_EQ(s21_multiset.size(), 10000U);
+  EXPECT_EQ(s21_multiset.distinct(), 50U);
+  s21_multiset.clear();
+  EXPECT_TRUE(s21_multiset.empty());
+}
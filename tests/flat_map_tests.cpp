@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+
+#include "../s21_flat_map.h"
+
+TEST(flat_map_constructor, case1) {
+  s21::flat_map<int, std::string> s21_map = {
+      {3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+  std::map<int, std::string> std_map = {
+      {3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  auto it = s21_map.begin();
+  for (const auto &elem : std_map) {
+    EXPECT_EQ(it->first, elem.first);
+    EXPECT_EQ(it->second, elem.second);
+    ++it;
+  }
+  EXPECT_TRUE(it == s21_map.end());
+
+  s21::flat_map<int, std::string> s21_map_copy(s21_map);
+  s21::flat_map<int, std::string> s21_map_move(std::move(s21_map));
+  EXPECT_EQ(s21_map_copy.size(), 3U);
+  EXPECT_EQ(s21_map_move.at(1), "one");
+  EXPECT_TRUE(s21_map.empty());
+}
+
+TEST(flat_map_insert, case1) {
+  s21::flat_map<int, int> s21_map;
+  std::map<int, int> std_map;
+  for (int i = 0; i < 2000; ++i) {
+    int key = (i * 37) % 1500;
+    EXPECT_EQ(s21_map.insert(key, i).second,
+              std_map.insert({key, i}).second);
+  }
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  auto it = s21_map.begin();
+  for (const auto &elem : std_map) {
+    EXPECT_EQ(it->first, elem.first);
+    EXPECT_EQ(it->second, elem.second);
+    ++it;
+  }
+}
+
+TEST(flat_map_insert_many, case1) {
+  s21::flat_map<int, char> s21_map = {{2, 'b'}, {4, 'd'}};
+  auto res = s21_map.insert_many(std::pair<int, char>(5, 'e'),
+                                 std::pair<int, char>(1, 'a'),
+                                 std::pair<int, char>(4, 'x'),
+                                 std::pair<int, char>(1, 'y'));
+
+  ASSERT_EQ(res.size(), 4U);
+  EXPECT_TRUE(res[0].second);
+  EXPECT_TRUE(res[1].second);
+  EXPECT_FALSE(res[2].second);
+  EXPECT_FALSE(res[3].second);
+  EXPECT_EQ(res[0].first->second, 'e');
+  EXPECT_EQ(res[2].first->second, 'd');
+  EXPECT_EQ(res[3].first->second, 'a');
+  EXPECT_EQ(s21_map.size(), 4U);
+
+  std::string keys;
+  for (const auto &elem : s21_map) keys += elem.second;
+  EXPECT_EQ(keys, "abde");
+}
+
+TEST(flat_map_insert_many, case2) {
+  s21::flat_map<std::string, std::string> s21_map = {{"b", "bee"}};
+  auto res = s21_map.insert_many(
+      std::pair<std::string, std::string>("c", "sea"),
+      std::pair<std::string, std::string>("b", "be"),
+      std::pair<std::string, std::string>("a", "ay"),
+      std::pair<std::string, std::string>("c", "see"));
+
+  ASSERT_EQ(res.size(), 4U);
+  EXPECT_EQ(res[0].first->first, "c");
+  EXPECT_EQ(res[0].first->second, "sea");
+  EXPECT_EQ(res[1].first->second, "bee");
+  EXPECT_EQ(res[2].first, s21_map.begin());
+  EXPECT_EQ(res[3].first, res[0].first);
+  EXPECT_FALSE(res[3].second);
+  EXPECT_EQ(s21_map.size(), 3U);
+}
+
+TEST(flat_map_lookup, case1) {
+  s21::flat_map<int, int> s21_map;
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 100; ++i) items.emplace_back(i * 2, i);
+  s21_map.insert(items.begin(), items.end());
+
+  EXPECT_EQ(s21_map.find(40)->second, 20);
+  EXPECT_TRUE(s21_map.find(41) == s21_map.end());
+  EXPECT_EQ(s21_map.lower_bound(41)->first, 42);
+  EXPECT_EQ(s21_map.upper_bound(42)->first, 44);
+  EXPECT_TRUE(s21_map.lower_bound(199) == s21_map.end());
+  auto range = s21_map.equal_range(10);
+  EXPECT_EQ(range.second - range.first, 1);
+  EXPECT_EQ(s21_map.count(10), 1U);
+  EXPECT_EQ(s21_map.count(11), 0U);
+  EXPECT_THROW(s21_map.at(11), std::out_of_range);
+
+  s21_map[11] = 7;
+  EXPECT_EQ(s21_map.at(11), 7);
+  s21_map.insert_or_assign(11, 8);
+  EXPECT_EQ(s21_map[11], 8);
+  EXPECT_EQ(s21_map.size(), 101U);
+}
+
+TEST(flat_map_erase, case1) {
+  s21::flat_map<int, int> s21_map = {{1, 1}, {2, 2}, {3, 3}, {4, 4}};
+  auto it = s21_map.erase(s21_map.find(2));
+  EXPECT_EQ(it->first, 3);
+  EXPECT_EQ(s21_map.erase(4), 1U);
+  EXPECT_EQ(s21_map.erase(4), 0U);
+  EXPECT_EQ(s21_map.size(), 2U);
+  EXPECT_FALSE(s21_map.contains(2));
+}
+
+TEST(flat_map_merge, case1) {
+  s21::flat_map<int, char> s21_map = {{1, 'a'}, {3, 'c'}};
+  s21::flat_map<int, char> s21_map_other = {{2, 'b'}, {3, 'x'}, {4, 'd'}};
+  s21_map.merge(s21_map_other);
+
+  EXPECT_TRUE(s21_map_other.empty());
+  std::string values;
+  for (const auto &elem : s21_map) values += elem.second;
+  EXPECT_EQ(values, "abcd");
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+#include "../s21_flat_set.h"
+
+TEST(flat_set_constructor, case1) {
+  std::vector<std::string> words = {"delta", "alpha", "charlie", "alpha"};
+  s21::flat_set<std::string> s21_set(words.begin(), words.end());
+
+  EXPECT_EQ(s21_set.size(), 3U);
+  EXPECT_EQ(*s21_set.begin(), "alpha");
+
+  s21::flat_set<std::string> s21_set_copy;
+  s21_set_copy = s21_set;
+  EXPECT_EQ(s21_set_copy.size(), 3U);
+  EXPECT_TRUE(s21_set_copy.contains("charlie"));
+}
+
+TEST(flat_set_insert, case1) {
+  s21::flat_set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 3000; ++i) {
+    int key = (i * 31) % 2000;
+    EXPECT_EQ(s21_set.insert(key).second, std_set.insert(key).second);
+  }
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  auto it = s21_set.begin();
+  for (int key : std_set) EXPECT_EQ(*it++, key);
+  EXPECT_TRUE(it == s21_set.end());
+}
+
+TEST(flat_set_insert_many, case1) {
+  s21::flat_set<int> s21_set = {10, 20, 30};
+  auto res = s21_set.insert_many(25, 5, 20, 5, 35);
+
+  ASSERT_EQ(res.size(), 5U);
+  EXPECT_TRUE(res[0].second);
+  EXPECT_TRUE(res[1].second);
+  EXPECT_FALSE(res[2].second);
+  EXPECT_FALSE(res[3].second);
+  EXPECT_TRUE(res[4].second);
+  for (const auto &elem : res) EXPECT_TRUE(elem.first != s21_set.end());
+  EXPECT_EQ(*res[3].first, 5);
+
+  std::set<int> std_set = {5, 10, 20, 25, 30, 35};
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  auto it = s21_set.begin();
+  for (int key : std_set) EXPECT_EQ(*it++, key);
+}
+
+TEST(flat_set_lookup, case1) {
+  s21::flat_set<int> s21_set = {1, 3, 5, 7};
+  EXPECT_EQ(*s21_set.find(5), 5);
+  EXPECT_TRUE(s21_set.find(4) == s21_set.end());
+  EXPECT_EQ(*s21_set.lower_bound(4), 5);
+  EXPECT_EQ(*s21_set.upper_bound(5), 7);
+  EXPECT_TRUE(s21_set.upper_bound(7) == s21_set.end());
+  EXPECT_EQ(s21_set.erase(3), 1U);
+  s21_set.erase(s21_set.begin());
+  EXPECT_EQ(s21_set.size(), 2U);
+  EXPECT_EQ(*s21_set.begin(), 5);
+  EXPECT_EQ(s21_set.count(7), 1U);
+}
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <limits>
 #include <map>
+#include <string_view>
 
+#include "../s21_allocator.h"
 #include "../s21_map.h"
 
 TEST(map_constructor, case1) {
@@ -545,7 +549,7 @@ TEST(map_begin, case3) {
 TEST(map_begin, case4) {
   s21::map<int, double> s21_map;
 
-  EXPECT_THROW(s21_map.begin(), std::out_of_range);
+  EXPECT_EQ(s21_map.begin(), s21_map.end());
 }
 
 TEST(map_begin, case5) {
@@ -581,7 +585,7 @@ TEST(map_end, case1) {
 
   s21::map<int, double> s21_map = {pair1, pair2, pair3, pair4, pair5};
 
-  auto max_value = s21_map.end();
+  auto max_value = std::prev(s21_map.end());
 
   EXPECT_EQ(max_value->first, 23);
 }
@@ -595,7 +599,7 @@ TEST(map_end, case2) {
 
   s21::map<double, std::string> s21_map = {pair1, pair2, pair3, pair4, pair5};
 
-  auto max_value = s21_map.end();
+  auto max_value = std::prev(s21_map.end());
 
   EXPECT_EQ(max_value->first, 11.400000001);
 }
@@ -609,7 +613,7 @@ TEST(map_end, case3) {
 
   s21::map<std::string, int> s21_map = {pair1, pair2, pair3, pair4, pair5};
 
-  auto max_value = s21_map.end();
+  auto max_value = std::prev(s21_map.end());
 
   EXPECT_EQ(max_value->first, "hola-hola");
 }
@@ -617,7 +621,7 @@ TEST(map_end, case3) {
 TEST(map_end, case4) {
   s21::map<int, double> s21_map;
 
-  EXPECT_THROW(s21_map.end(), std::out_of_range);
+  EXPECT_EQ(s21_map.end(), s21_map.begin());
 }
 
 TEST(map_end, case5) {
@@ -625,7 +629,7 @@ TEST(map_end, case5) {
 
   s21::map<double, std::string> s21_map = {pair1, pair1};
 
-  auto max_value = s21_map.end();
+  auto max_value = std::prev(s21_map.end());
 
   EXPECT_EQ(max_value->first, 1.4);
   EXPECT_EQ(max_value->second, "hello");
@@ -638,7 +642,7 @@ TEST(map_end, case6) {
 
   s21::map<std::string, int> s21_map = {pair1, pair2, pair3};
 
-  auto max_value = s21_map.end();
+  auto max_value = std::prev(s21_map.end());
 
   EXPECT_EQ(max_value->first, "hello");
   EXPECT_EQ(max_value->second, 1);
@@ -651,7 +655,7 @@ TEST(map_balance, case1) {
 
   s21::map<int, double> s21_map = {pair1, pair2, pair3};
 
-  auto max_value = s21_map.end();
+  auto max_value = std::prev(s21_map.end());
 
   EXPECT_EQ(max_value->first, 15);
   EXPECT_EQ(s21_map.size(), 3U);
@@ -664,7 +668,7 @@ TEST(map_balance, case2) {
 
   s21::map<double, std::string> s21_map = {pair1, pair2, pair3};
 
-  auto min_value = s21_map.end();
+  auto min_value = std::prev(s21_map.end());
 
   EXPECT_EQ(min_value->first, 11.4);
   EXPECT_EQ(s21_map.size(), 3U);
@@ -679,7 +683,7 @@ TEST(map_balance, case3) {
 
   s21::map<std::string, int> s21_map = {pair1, pair2, pair3, pair4, pair5};
 
-  auto min_value = s21_map.end();
+  auto min_value = std::prev(s21_map.end());
 
   EXPECT_EQ(min_value->first, "hola-hola");
   EXPECT_EQ(s21_map.size(), 5U);
@@ -694,7 +698,7 @@ TEST(map_balance, case4) {
 
   s21::map<int, int> s21_map = {pair1, pair2, pair3, pair4, pair5};
 
-  EXPECT_EQ(s21_map.end()->first, 1543);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 1543);
   EXPECT_EQ(s21_map.begin()->first, 5);
   EXPECT_EQ(s21_map.size(), 5U);
 }
@@ -713,7 +717,7 @@ TEST(map_balance, case5) {
   s21::map<int, int> s21_map = {pair1, pair2, pair3, pair4, pair5,
                                 pair6, pair7, pair8, pair9};
 
-  EXPECT_EQ(s21_map.end()->first, 60);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 60);
   EXPECT_EQ(s21_map.begin()->first, 1);
   EXPECT_EQ(s21_map.size(), 9U);
 }
@@ -737,26 +741,26 @@ TEST(map_erase, case1) {
   it++;
   s21_map.erase(it);
   EXPECT_EQ(s21_map.begin()->first, 4);
-  EXPECT_EQ(s21_map.end()->first, 18);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 18);
   EXPECT_EQ(s21_map.size(), 6U);
 
   it = s21_map.begin();
   s21_map.erase(it);
   EXPECT_EQ(s21_map.begin()->first, 5);
-  EXPECT_EQ(s21_map.end()->first, 18);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 18);
   EXPECT_EQ(s21_map.size(), 5U);
 
   it = s21_map.begin();
   it++;
   s21_map.erase(it);
   EXPECT_EQ(s21_map.begin()->first, 5);
-  EXPECT_EQ(s21_map.end()->first, 18);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 18);
   EXPECT_EQ(s21_map.size(), 4U);
 
-  it = s21_map.end();
+  it = std::prev(s21_map.end());
   s21_map.erase(it);
   EXPECT_EQ(s21_map.begin()->first, 5);
-  EXPECT_EQ(s21_map.end()->first, 16);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 16);
   EXPECT_EQ(s21_map.size(), 3U);
 
   it = s21_map.begin();
@@ -797,21 +801,21 @@ TEST(map_erase, case3) {
 
   s21::map<std::string, int> s21_map = {pair1, pair2, pair3, pair4, pair5};
 
-  auto it = s21_map.end();
+  auto it = std::prev(s21_map.end());
   s21_map.erase(it);
-  EXPECT_EQ(s21_map.end()->first, "hola");
+  EXPECT_EQ(std::prev(s21_map.end())->first, "hola");
   EXPECT_EQ(s21_map.size(), 4U);
 
-  it = s21_map.end();
+  it = std::prev(s21_map.end());
   s21_map.erase(it);
-  EXPECT_EQ(s21_map.end()->first, "hi");
+  EXPECT_EQ(std::prev(s21_map.end())->first, "hi");
   EXPECT_EQ(s21_map.size(), 3U);
 
   s21_map.insert(pair3);
   s21_map.insert(pair4);
-  it = s21_map.end();
+  it = std::prev(s21_map.end());
   s21_map.erase(it);
-  EXPECT_EQ(s21_map.end()->first, "hola");
+  EXPECT_EQ(std::prev(s21_map.end())->first, "hola");
   EXPECT_EQ(s21_map.size(), 4U);
 }
 
@@ -824,10 +828,10 @@ TEST(map_erase, case4) {
 
   s21::map<double, int> s21_map = {pair1, pair2, pair3, pair4, pair5};
 
-  auto it = s21_map.end();
+  auto it = std::prev(s21_map.end());
   it--;
   s21_map.erase(it);
-  it = s21_map.end();
+  it = std::prev(s21_map.end());
   EXPECT_EQ(it->first, 941.44);
   EXPECT_EQ(s21_map.size(), 4U);
 
@@ -840,7 +844,7 @@ TEST(map_erase, case4) {
   ++it;
   ++it;
   ++it;
-  EXPECT_EQ(s21_map.end()->first, 44.48);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 44.48);
   EXPECT_EQ(s21_map.size(), 3U);
 }
 
@@ -930,7 +934,7 @@ TEST(map_erase, case9) {
   s21::map<double, int> s21_map = {pair1, pair2, pair3, pair4,
                                    pair5, pair6, pair7, pair8};
 
-  auto it = s21_map.end();
+  auto it = std::prev(s21_map.end());
   it -= 4;
   s21_map.erase(it);
   it = s21_map.begin();
@@ -948,7 +952,6 @@ TEST(map_erase, case10) {
 
   auto it = s21_map.end();
   it -= 1;
-  ++it;
   s21_map.erase(it);
   EXPECT_EQ(s21_map.size(), 0U);
 }
@@ -1255,7 +1258,7 @@ TEST(map_merge, case4) {
   EXPECT_EQ(s21_map_int_res.size(), 6U);
 }
 
-TEST(map_emplace, case1) {
+TEST(map_insert_many, case1) {
   std::pair<int, double> pair1{9, 1.4};
   std::pair<int, double> pair2{9, 1.4};
   std::pair<int, double> pair3{9, 1.4};
@@ -1264,15 +1267,15 @@ TEST(map_emplace, case1) {
 
   s21::map<int, double> s21_map;
 
-  std::vector<std::pair<s21::map<int, double>::iterator, bool>> emplace1 =
-      s21_map.emplace(pair1, pair2, pair3, pair4, pair5);
+  std::vector<std::pair<s21::map<int, double>::iterator, bool>> inserted =
+      s21_map.insert_many(pair1, pair2, pair3, pair4, pair5);
 
-  EXPECT_EQ(emplace1[0].first->first, 9);
-  EXPECT_EQ(emplace1[0].second, true);
+  EXPECT_EQ(inserted[0].first->first, 9);
+  EXPECT_EQ(inserted[0].second, true);
   EXPECT_EQ(s21_map.size(), 3U);
 }
 
-TEST(map_emplace, case2) {
+TEST(map_insert_many, case2) {
   std::pair<double, std::string> pair1{1.4, "hello"};
   std::pair<double, std::string> pair2{2.77, "hi"};
   std::pair<double, std::string> pair3{3.9, "hola"};
@@ -1282,14 +1285,14 @@ TEST(map_emplace, case2) {
   s21::map<double, std::string> s21_map;
 
   std::vector<std::pair<s21::map<double, std::string>::iterator, bool>>
-      emplace1 = s21_map.emplace(pair1, pair2, pair3);
+      inserted = s21_map.insert_many(pair1, pair2, pair3);
 
-  EXPECT_EQ(emplace1[0].first->first, 2.77);
-  EXPECT_EQ(emplace1[0].second, true);
+  EXPECT_EQ(inserted[0].first->first, 1.4);
+  EXPECT_EQ(inserted[0].second, true);
   EXPECT_EQ(s21_map.size(), 3U);
 }
 
-TEST(map_emplace, case3) {
+TEST(map_insert_many, case3) {
   std::pair<std::string, int> pair1{"hello", 1};
   std::pair<std::string, int> pair2{"hi", 2};
   std::pair<std::string, int> pair3{"hi", 2};
@@ -1298,49 +1301,983 @@ TEST(map_emplace, case3) {
 
   s21::map<std::string, int> s21_map;
 
-  std::vector<std::pair<s21::map<std::string, int>::iterator, bool>> emplace1 =
-      s21_map.emplace(pair1, pair2, pair3, pair4, pair5);
+  std::vector<std::pair<s21::map<std::string, int>::iterator, bool>> inserted =
+      s21_map.insert_many(pair1, pair2, pair3, pair4, pair5);
 
-  EXPECT_EQ(emplace1[0].first->first, "hi");
-  EXPECT_EQ(emplace1[0].second, true);
+  EXPECT_EQ(inserted[0].first->first, "hello");
+  EXPECT_EQ(inserted[0].second, true);
   EXPECT_EQ(s21_map.size(), 3U);
 }
 
-TEST(map_emplace, case4) {
+TEST(map_insert_many, case4) {
   std::pair<int, double> pair1{9, 1.4};
 
   s21::map<int, double> s21_map;
 
-  std::vector<std::pair<s21::map<int, double>::iterator, bool>> emplace1 =
-      s21_map.emplace(pair1);
+  std::vector<std::pair<s21::map<int, double>::iterator, bool>> inserted =
+      s21_map.insert_many(pair1);
 
-  EXPECT_EQ(emplace1[0].first->first, 9);
-  EXPECT_EQ(emplace1[0].second, true);
+  EXPECT_EQ(inserted[0].first->first, 9);
+  EXPECT_EQ(inserted[0].second, true);
   EXPECT_EQ(s21_map.size(), 1U);
 }
 
-TEST(map_emplace, case5) {
+TEST(map_insert_many, case5) {
   std::pair<double, std::string> pair1{1.4, "hello"};
 
   s21::map<double, std::string> s21_map = {pair1};
 
   std::vector<std::pair<s21::map<double, std::string>::iterator, bool>>
-      emplace1 = s21_map.emplace(pair1);
+      inserted = s21_map.insert_many(pair1);
 
-  EXPECT_EQ(emplace1[0].second, false);
+  EXPECT_EQ(inserted[0].second, false);
   EXPECT_EQ(s21_map.size(), 1U);
 }
 
-TEST(map_emplace, case6) {
+TEST(map_insert_many, case6) {
   std::pair<std::string, int> pair1{"hello", 1};
   std::pair<std::string, int> pair2{"hi", 2};
 
   s21::map<std::string, int> s21_map = {pair1};
 
-  std::vector<std::pair<s21::map<std::string, int>::iterator, bool>> emplace1 =
-      s21_map.emplace(pair2);
+  std::vector<std::pair<s21::map<std::string, int>::iterator, bool>> inserted =
+      s21_map.insert_many(pair2);
+
+  EXPECT_EQ(inserted[0].first->first, "hi");
+  EXPECT_EQ(inserted[0].second, true);
+  EXPECT_EQ(s21_map.size(), 2U);
+}
+
+TEST(map_iterator, case1) {
+  s21::map<int, int> s21_map;
+  std::vector<s21::map<int, int>::iterator> iters;
+  for (int i = 0; i < 64; ++i) iters.push_back(s21_map.insert(i, i * 10).first);
+
+  for (int i = 0; i < 64; ++i) {
+    EXPECT_EQ(iters[i]->first, i);
+    EXPECT_EQ(iters[i]->second, i * 10);
+  }
+  for (int i = 0; i < 64; i += 2) s21_map.erase(iters[i]);
+  for (int i = 1; i < 64; i += 2) EXPECT_EQ(iters[i]->first, i);
+  EXPECT_EQ(s21_map.size(), 32U);
+}
+
+TEST(map_balance, case6) {
+  s21::map<int, int> s21_map;
+  std::map<int, int> std_map;
+  unsigned seed = 7;
+  for (int i = 0; i < 2000; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>(seed % 500U);
+    if (seed & 0x10000U) {
+      s21_map.insert(key, i);
+      std_map.insert({key, i});
+    } else if (s21_map.contains(key)) {
+      auto it = s21_map.begin();
+      while (it->first != key) ++it;
+      s21_map.erase(it);
+      std_map.erase(key);
+    }
+  }
+
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  auto it = s21_map.begin();
+  for (auto std_it = std_map.begin(); std_it != std_map.end(); ++std_it) {
+    EXPECT_EQ(it->first, std_it->first);
+    EXPECT_EQ(it->second, std_it->second);
+    ++it;
+  }
+}
+
+TEST(map_size, case1) {
+  s21::map<int, int> s21_map;
+  for (int i = 0; i < 100; ++i) s21_map.insert(i % 70, i);
+  EXPECT_EQ(s21_map.size(), 70U);
+
+  s21::map<int, int> s21_map_other = {{100, 1}, {5, 1}, {101, 1}};
+  s21_map.merge(s21_map_other);
+  EXPECT_EQ(s21_map.size(), 72U);
+  EXPECT_EQ(s21_map_other.size(), 0U);
+  EXPECT_TRUE(s21_map_other.empty());
+
+  s21::map<int, int> s21_map_copy(s21_map);
+  EXPECT_EQ(s21_map_copy.size(), 72U);
+  s21_map_copy.erase(s21_map_copy.begin());
+  EXPECT_EQ(s21_map_copy.size(), 71U);
+
+  s21_map.swap(s21_map_copy);
+  EXPECT_EQ(s21_map.size(), 71U);
+  EXPECT_EQ(s21_map_copy.size(), 72U);
+
+  s21_map.clear();
+  EXPECT_EQ(s21_map.size(), 0U);
+  EXPECT_TRUE(s21_map.empty());
+}
+
+TEST(map_at, case2) {
+  s21::map<int, double> s21_map = {{9, 1.4}, {23, 2.77}};
+  s21_map.at(9) = 4.5;
+
+  EXPECT_EQ(s21_map.at(9), 4.5);
+  EXPECT_THROW(s21_map.at(10), std::out_of_range);
+}
+
+TEST(map_find, case1) {
+  s21::map<std::string, int> s21_map = {{"hello", 1}, {"hi", 2}, {"hola", 3}};
+
+  auto it = s21_map.find("hi");
+  EXPECT_EQ(it->first, "hi");
+  EXPECT_EQ(it->second, 2);
+  it->second = 20;
+  EXPECT_EQ(s21_map["hi"], 20);
+
+  EXPECT_EQ(s21_map.find("bonjour"), s21_map.end());
+}
+
+TEST(map_count, case1) {
+  s21::map<int, int> s21_map = {{1, 1}, {2, 2}, {3, 3}};
+
+  EXPECT_EQ(s21_map.count(2), 1U);
+  EXPECT_EQ(s21_map.count(4), 0U);
+}
+
+TEST(map_erase, case11) {
+  s21::map<int, int> s21_map;
+  for (int i = 0; i < 100; ++i) s21_map[i] = i;
+
+  for (int i = 0; i < 100; i += 3) EXPECT_EQ(s21_map.erase(i), 1U);
+  EXPECT_EQ(s21_map.erase(0), 0U);
+  EXPECT_EQ(s21_map.erase(1000), 0U);
+  EXPECT_EQ(s21_map.size(), 66U);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(s21_map.contains(i), i % 3 != 0);
+}
+
+TEST(map_insert_or_assign, case1) {
+  s21::map<int, std::string> s21_map = {{1, "one"}, {2, "two"}};
+
+  auto res1 = s21_map.insert_or_assign(2, "deux");
+  EXPECT_EQ(res1.second, false);
+  EXPECT_EQ(res1.first->first, 2);
+  EXPECT_EQ(s21_map.at(2), "deux");
+
+  auto res2 = s21_map.insert_or_assign(3, "trois");
+  EXPECT_EQ(res2.second, true);
+  EXPECT_EQ(res2.first->second, "trois");
+  EXPECT_EQ(s21_map.size(), 3U);
+}
+
+TEST(map_bounds, case1) {
+  s21::map<int, std::string> s21_map = {{1, "a"}, {5, "b"}, {9, "c"}};
+
+  EXPECT_EQ(s21_map.lower_bound(5)->second, "b");
+  EXPECT_EQ(s21_map.lower_bound(6)->second, "c");
+  EXPECT_EQ(s21_map.upper_bound(5)->second, "c");
+  EXPECT_EQ(s21_map.upper_bound(0)->second, "a");
+  EXPECT_TRUE(s21_map.upper_bound(9) == s21_map.lower_bound(10));
+  EXPECT_EQ(s21_map.upper_bound(9), s21_map.end());
+
+  auto range = s21_map.equal_range(1);
+  EXPECT_EQ(range.first->first, 1);
+  EXPECT_EQ(range.second->first, 5);
+}
+
+TEST(map_order_statistics, case1) {
+  s21::map<std::string, int> s21_map = {{"d", 4}, {"a", 1}, {"c", 3}, {"b", 2}};
+
+  EXPECT_EQ(s21_map.nth(2)->first, "c");
+  EXPECT_EQ(s21_map.rank("c"), 2U);
+  EXPECT_EQ(s21_map.rank("bb"), 2U);
+}
+
+TEST(map_order_statistics, case2) {
+  s21::map<int, int> s21_map;
+  for (int i = 0; i < 1000; ++i) s21_map.insert(i * 2, i);
+
+  EXPECT_EQ(s21_map.nth(0)->first, 0);
+  EXPECT_EQ(s21_map.nth(999)->first, 1998);
+  EXPECT_EQ(s21_map.nth(321)->first, 642);
+  EXPECT_THROW(s21_map.nth(1000), std::out_of_range);
+  EXPECT_EQ(s21_map.rank(643), 322U);
+  EXPECT_EQ(s21_map.count(642), 1U);
+  EXPECT_EQ(s21_map.count(643), 0U);
+  EXPECT_LE(s21_map.max_size(), std::numeric_limits<std::uint32_t>::max());
+
+  for (int i = 0; i < 1000; i += 2) s21_map.erase(i * 2);
+  EXPECT_EQ(s21_map.nth(0)->first, 2);
+  EXPECT_EQ(s21_map.rank(1000), 250U);
+}
+
+TEST(map_order_statistics, case3) {
+  s21::map<int, int> s21_map;
+  for (int i = 0; i < 1000; ++i) s21_map.insert(i, i);
+  auto firsts = s21_map.slices(4);
+  ASSERT_EQ(firsts.size(), 4U);
+  EXPECT_EQ(firsts[0], s21_map.begin());
+  EXPECT_EQ(firsts[1]->first, 250);
+  EXPECT_EQ(firsts[3]->first, 750);
+  EXPECT_EQ(s21_map.slices(5000).size(), 1000U);
+
+  s21::Tree<int, int, std::less<>, std::allocator<std::pair<const int, int>>,
+            false>
+      s21_tree;
+  for (int i = 0; i < 1000; ++i) s21_tree.insert({i, i});
+  EXPECT_EQ(s21_tree.nth(990)->first, 990);
+  EXPECT_EQ(s21_tree.rank(500), 500U);
+  auto pieces = s21_tree.slices(6);
+  ASSERT_GE(pieces.size(), 2U);
+  ASSERT_LE(pieces.size(), 6U);
+  EXPECT_EQ(pieces[0], s21_tree.begin());
+  for (std::size_t i = 1; i < pieces.size(); ++i)
+    EXPECT_LT(pieces[i - 1]->first, pieces[i]->first);
+}
+
+TEST(map_order_statistics, case4) {
+  using unranked_map =
+      s21::map<int, int, std::less<>, std::allocator<std::pair<const int, int>>,
+               false>;
+  unranked_map s21_map, s21_map_greater;
+  for (int i = 0; i < 1000; ++i) s21_map.insert(i, i);
+  // Only subtree counts cap the size.
+  EXPECT_GT(s21_map.max_size(), std::numeric_limits<std::uint32_t>::max());
+
+  EXPECT_EQ(s21_map.nth(10)->first, 10);
+  EXPECT_EQ(s21_map.rank(500), 500U);
+  EXPECT_EQ(s21_map.count(500), 1U);
+  s21_map.split(300, s21_map_greater);
+  EXPECT_EQ(s21_map.size(), 300U);
+  EXPECT_EQ(s21_map_greater.size(), 700U);
+  EXPECT_EQ(s21_map_greater.extract_range(400, 500).size(), 100U);
+  EXPECT_EQ(s21_map_greater.size(), 600U);
+}
+
+TEST(map_assign, case1) {
+  std::vector<std::pair<int, std::string>> items = {
+      {3, "c"}, {1, "a"}, {2, "b"}, {1, "duplicate"}};
+  s21::map<int, std::string> s21_map(items.begin(), items.end());
+
+  EXPECT_EQ(s21_map.size(), 3U);
+  EXPECT_EQ(s21_map.at(1), "a");
+
+  std::map<int, std::string> std_map = {{7, "g"}, {8, "h"}};
+  s21_map.assign(std_map.begin(), std_map.end());
+  EXPECT_EQ(s21_map.size(), 2U);
+  EXPECT_EQ(s21_map.begin()->second, "g");
+  EXPECT_FALSE(s21_map.contains(1));
+}
+
+TEST(map_algebra, case1) {
+  s21::map<int, std::string> s21_map = {{1, "a"}, {2, "b"}, {3, "c"}};
+  s21::map<int, std::string> s21_map_other = {{2, "x"}, {3, "y"}, {4, "z"}};
+
+  s21::map<int, std::string> united = s21_map;
+  united.unite(s21_map_other);
+  EXPECT_EQ(united.size(), 4U);
+  EXPECT_EQ(united.at(2), "b");
+  EXPECT_EQ(united.at(4), "z");
 
-  EXPECT_EQ(emplace1[0].first->first, "hi");
-  EXPECT_EQ(emplace1[0].second, true);
+  s21::map<int, std::string> common = s21_map;
+  common.intersect(s21_map_other);
+  EXPECT_EQ(common.size(), 2U);
+  EXPECT_EQ(common.at(3), "c");
+
+  s21_map.subtract(s21_map_other);
+  EXPECT_EQ(s21_map.size(), 1U);
+  EXPECT_EQ(s21_map.begin()->first, 1);
+
+  s21_map.merge(s21_map_other);
+  EXPECT_EQ(s21_map.size(), 4U);
+  EXPECT_EQ(s21_map.at(2), "x");
+}
+
+TEST(map_split, case1) {
+  s21::map<int, int> s21_map;
+  for (int i = 0; i < 1000; ++i) s21_map.insert(i, i * 2);
+  s21::map<int, int> s21_map_greater = {{5000, 1}};
+
+  s21_map.split(400, s21_map_greater);
+  EXPECT_EQ(s21_map.size(), 400U);
+  EXPECT_EQ(s21_map_greater.size(), 600U);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 399);
+  EXPECT_EQ(s21_map_greater.begin()->first, 400);
+  EXPECT_FALSE(s21_map_greater.contains(5000));
+
+  s21_map.join(s21_map_greater);
+  EXPECT_EQ(s21_map.size(), 1000U);
+  EXPECT_TRUE(s21_map_greater.empty());
+  EXPECT_EQ(s21_map.at(700), 1400);
+  EXPECT_EQ(s21_map.rank(700), 700U);
+}
+
+TEST(map_split, case2) {
+  using unranked_tree =
+      s21::Tree<int, int, std::less<>,
+                std::allocator<std::pair<const int, int>>, false>;
+  unranked_tree s21_tree, s21_tree_greater;
+  for (int i = 0; i < 1000; ++i) s21_tree.insert({i, i});
+
+  s21_tree.split(400, s21_tree_greater);
+  EXPECT_EQ(s21_tree.size(), 400U);
+  EXPECT_EQ(s21_tree_greater.size(), 600U);
+  EXPECT_EQ(s21_tree_greater.begin()->first, 400);
+
+  s21_tree_greater.split(-1, s21_tree);
+  EXPECT_EQ(s21_tree_greater.size(), 0U);
+  EXPECT_EQ(s21_tree.size(), 600U);
+  s21_tree.split(5000, s21_tree_greater);
+  EXPECT_EQ(s21_tree.size(), 600U);
+  EXPECT_EQ(s21_tree_greater.size(), 0U);
+}
+
+TEST(map_join, case1) {
+  s21::map<int, int> s21_map = {{1, 1}, {5, 5}};
+  s21::map<int, int> s21_map_other = {{5, 6}, {9, 9}};
+
+  EXPECT_THROW(s21_map.join(s21_map_other), std::invalid_argument);
   EXPECT_EQ(s21_map.size(), 2U);
+  EXPECT_EQ(s21_map_other.size(), 2U);
+}
+
+TEST(map_allocator, case1) {
+  using pool_map =
+      s21::map<int, std::string, std::less<>,
+               s21::node_pool_allocator<std::pair<const int, std::string>>>;
+  pool_map s21_map;
+  for (int i = 0; i < 1000; ++i) s21_map.insert(i, std::to_string(i));
+  for (int i = 0; i < 1000; i += 2) s21_map.erase(i);
+  for (int i = 0; i < 1000; i += 4) s21_map.insert(i, "again");
+  EXPECT_EQ(s21_map.size(), 750U);
+  EXPECT_EQ(s21_map.at(8), "again");
+
+  pool_map s21_map_other = {{-1, "a"}, {1, "b"}, {2000, "c"}};
+  s21_map.merge(s21_map_other);
+  EXPECT_EQ(s21_map.size(), 752U);
+  EXPECT_TRUE(s21_map_other.empty());
+
+  pool_map s21_map_copy(s21_map);
+  EXPECT_TRUE(s21_map_copy.get_allocator() == s21_map.get_allocator());
+  s21_map_copy.split(500, s21_map_other);
+  s21_map_copy.clear();
+  EXPECT_EQ(s21_map_other.size(), 376U);
+  EXPECT_EQ(s21_map_other.at(2000), "c");
+}
+
+TEST(map_allocator, case2) {
+  using pool_alloc =
+      s21::node_pool_allocator<std::pair<const int, std::string>>;
+  using pool_map = s21::map<int, std::string, std::less<>, pool_alloc>;
+  pool_alloc alloc;
+  pool_map s21_map(alloc);
+  pool_map s21_map_other(alloc);
+  EXPECT_TRUE(s21_map.get_allocator() == alloc);
+  EXPECT_TRUE(s21_map.get_allocator() == s21_map_other.get_allocator());
+
+  for (int i = 0; i < 100; i += 2) s21_map.insert(i, "even");
+  for (int i = 1; i < 100; i += 2) s21_map_other.insert(i, "odd");
+  std::vector<const std::string *> elements;
+  for (auto &elem : s21_map_other) elements.push_back(&elem.second);
+
+  // Equal allocators let merge relink the nodes of other as they are.
+  s21_map.merge(s21_map_other);
+  EXPECT_TRUE(s21_map_other.empty());
+  ASSERT_EQ(s21_map.size(), 100U);
+  for (int i = 1; i < 100; i += 2)
+    EXPECT_EQ(&s21_map.at(i), elements[i / 2]);
+}
+
+// Fails once budget allocations have been made, and counts the nodes it
+// has live. Rebinds share the counters; allocators with different ids
+// compare unequal.
+struct AllocationBudget {
+  static int budget;
+  static int live;
+};
+int AllocationBudget::budget = -1;
+int AllocationBudget::live = 0;
+
+template <typename T>
+struct ThrowingAllocator : AllocationBudget {
+  using value_type = T;
+  ThrowingAllocator() = default;
+  explicit ThrowingAllocator(int id) : id(id) {}
+  template <typename U>
+  ThrowingAllocator(const ThrowingAllocator<U> &other) : id(other.id) {}
+  T *allocate(std::size_t n) {
+    if (!budget--) throw std::bad_alloc();
+    ++live;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *ptr, std::size_t n) {
+    --live;
+    std::allocator<T>().deallocate(ptr, n);
+  }
+  template <typename U>
+  bool operator==(const ThrowingAllocator<U> &other) const {
+    return id == other.id;
+  }
+  template <typename U>
+  bool operator!=(const ThrowingAllocator<U> &other) const {
+    return id != other.id;
+  }
+  int id = 0;
+};
+
+TEST(map_allocator, case3) {
+  using throwing_alloc = ThrowingAllocator<std::pair<const int, int>>;
+  using throwing_map = s21::map<int, int, std::less<>, throwing_alloc>;
+  {
+    throwing_map s21_map;
+    for (int i = 0; i < 100; ++i) s21_map.insert(i, i);
+    int live = AllocationBudget::live;
+
+    AllocationBudget::budget = 50;
+    EXPECT_THROW(throwing_map s21_map_copy(s21_map), std::bad_alloc);
+    EXPECT_EQ(AllocationBudget::live, live);
+
+    throwing_map s21_map_other = {{-1, -1}};
+    AllocationBudget::budget = 50;
+    EXPECT_THROW(s21_map_other = s21_map, std::bad_alloc);
+    EXPECT_EQ(AllocationBudget::live, live);
+    EXPECT_TRUE(s21_map_other.empty());
+
+    AllocationBudget::budget = 0;
+    EXPECT_THROW(s21_map.insert({1000, 1000}), std::bad_alloc);
+    EXPECT_EQ(s21_map.size(), 100U);
+
+    std::vector<std::pair<const int, int>> items;
+    for (int i = 200; i > 0; --i) items.emplace_back(i, i);
+    AllocationBudget::budget = 50;
+    EXPECT_THROW(s21_map_other.assign(items.begin(), items.end()),
+                 std::bad_alloc);
+    EXPECT_TRUE(s21_map_other.empty());
+    EXPECT_EQ(AllocationBudget::live, live);
+
+    s21_map_other.insert({-1, -1});
+    for (int i = 100; i < 200; ++i) s21_map_other.insert(i, i);
+    AllocationBudget::budget = 50;
+    EXPECT_THROW(s21_map.unite(s21_map_other), std::bad_alloc);
+    EXPECT_EQ(s21_map.size(), 100U);
+    EXPECT_EQ(AllocationBudget::live, live + 101);
+    AllocationBudget::budget = -1;
+  }
+  EXPECT_EQ(AllocationBudget::live, 0);
+}
+
+TEST(map_allocator, case6) {
+  using throwing_alloc = ThrowingAllocator<std::pair<const int, std::string>>;
+  using throwing_map = s21::map<int, std::string, std::less<>, throwing_alloc>;
+  {
+    throwing_map s21_map{throwing_alloc(1)};
+    throwing_map s21_map_other{throwing_alloc(2)};
+    for (int i = 0; i < 20; i += 2) s21_map.insert(i, "even");
+    for (int i = 0; i < 20; i += 3) s21_map_other.insert(i, "third");
+    int live = AllocationBudget::live;
+
+    // Unequal allocators: the three keys that go in get new nodes, and the
+    // third allocation fails before any element has moved.
+    AllocationBudget::budget = 2;
+    EXPECT_THROW(s21_map.merge(s21_map_other), std::bad_alloc);
+    AllocationBudget::budget = -1;
+    EXPECT_EQ(AllocationBudget::live, live);
+    EXPECT_EQ(s21_map.size(), 10U);
+    ASSERT_EQ(s21_map_other.size(), 7U);
+    int key = 0;
+    for (const auto &elem : s21_map_other) {
+      EXPECT_EQ(elem.first, key);
+      EXPECT_EQ(elem.second, "third");
+      key += 3;
+    }
+
+    s21_map.merge(s21_map_other);
+    EXPECT_TRUE(s21_map_other.empty());
+    EXPECT_EQ(s21_map.size(), 13U);
+    EXPECT_EQ(s21_map.at(6), "even");
+    EXPECT_EQ(s21_map.at(9), "third");
+    EXPECT_EQ(AllocationBudget::live, live - 4);
+  }
+  EXPECT_EQ(AllocationBudget::live, 0);
+}
+
+TEST(map_allocator, case7) {
+  using throwing_alloc = ThrowingAllocator<std::pair<const int, std::string>>;
+  using throwing_map = s21::map<int, std::string, std::less<>, throwing_alloc>;
+  {
+    throwing_map s21_map{throwing_alloc(1)};
+    throwing_map s21_map_greater{throwing_alloc(2)};
+    for (int i = 0; i < 10; ++i) s21_map.insert(i, "lower");
+    for (int i = 10; i < 20; ++i) s21_map_greater.insert(i, "greater");
+    int live = AllocationBudget::live;
+
+    AllocationBudget::budget = 5;
+    EXPECT_THROW(s21_map.join(s21_map_greater), std::bad_alloc);
+    AllocationBudget::budget = -1;
+    EXPECT_EQ(AllocationBudget::live, live);
+    EXPECT_EQ(s21_map.size(), 10U);
+    ASSERT_EQ(s21_map_greater.size(), 10U);
+    int key = 10;
+    for (const auto &elem : s21_map_greater) {
+      EXPECT_EQ(elem.first, key++);
+      EXPECT_EQ(elem.second, "greater");
+    }
+
+    s21_map.join(s21_map_greater);
+    EXPECT_TRUE(s21_map_greater.empty());
+    EXPECT_EQ(s21_map.size(), 20U);
+    EXPECT_EQ(s21_map.at(15), "greater");
+    EXPECT_EQ(s21_map.rank(15), 15U);
+    EXPECT_EQ(AllocationBudget::live, live);
+  }
+  EXPECT_EQ(AllocationBudget::live, 0);
+}
+
+TEST(map_allocator, case4) {
+  using pool_map =
+      s21::map<int, std::unique_ptr<int>, std::less<>,
+               s21::node_pool_allocator<
+                   std::pair<const int, std::unique_ptr<int>>>>;
+  pool_map s21_map, s21_map_other, s21_map_greater;
+  for (int i = 0; i < 10; i += 2) s21_map.emplace(i, std::make_unique<int>(i));
+  for (int i = 1; i < 10; i += 2)
+    s21_map_other.emplace(i, std::make_unique<int>(i));
+  for (int i = 10; i < 20; ++i)
+    s21_map_greater.emplace(i, std::make_unique<int>(i));
+  EXPECT_FALSE(s21_map.get_allocator() == s21_map_other.get_allocator());
+  const int *pointee = s21_map_other.at(5).get();
+
+  // Unequal allocators make merge and join move each element into a node
+  // of the target, which move-only values allow.
+  s21_map.merge(s21_map_other);
+  EXPECT_TRUE(s21_map_other.empty());
+  EXPECT_EQ(s21_map.at(5).get(), pointee);
+  s21_map.join(s21_map_greater);
+  EXPECT_TRUE(s21_map_greater.empty());
+  ASSERT_EQ(s21_map.size(), 20U);
+  for (int i = 0; i < 20; ++i) EXPECT_EQ(*s21_map.at(i), i);
+}
+
+// Holds at most three objects, to reach max_size() in a test.
+template <typename T>
+struct SmallAllocator : std::allocator<T> {
+  SmallAllocator() = default;
+  template <typename U>
+  SmallAllocator(const SmallAllocator<U> &) {}
+  template <typename U>
+  struct rebind {
+    using other = SmallAllocator<U>;
+  };
+  std::size_t max_size() const noexcept { return 3; }
+};
+
+TEST(map_allocator, case5) {
+  using small_map =
+      s21::map<int, int, std::less<>,
+               SmallAllocator<std::pair<const int, int>>>;
+  small_map s21_map = {{1, 1}, {2, 2}, {3, 3}};
+  small_map s21_map_other = {{4, 4}};
+  EXPECT_EQ(s21_map.max_size(), 3U);
+  EXPECT_THROW(s21_map.insert(4, 4), std::length_error);
+  EXPECT_THROW(s21_map.merge(s21_map_other), std::length_error);
+  EXPECT_THROW(s21_map.join(s21_map_other), std::length_error);
+  auto node = s21_map_other.extract(4);
+  EXPECT_THROW(s21_map.insert(std::move(node)), std::length_error);
+  EXPECT_EQ(s21_map.size(), 3U);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 3);
+  EXPECT_EQ(node.key(), 4);
+  EXPECT_TRUE(s21_map_other.empty());
+}
+
+// Counts how many keys get built, to show lookups never make one.
+struct CountedKey {
+  static int created;
+  std::string name;
+  CountedKey(const char *str) : name(str) { ++created; }
+  CountedKey(const CountedKey &other) : name(other.name) { ++created; }
+  friend bool operator<(const CountedKey &a, const CountedKey &b) {
+    return a.name < b.name;
+  }
+  friend bool operator<(const CountedKey &a, std::string_view b) {
+    return a.name < b;
+  }
+  friend bool operator<(std::string_view a, const CountedKey &b) {
+    return a < b.name;
+  }
+};
+int CountedKey::created = 0;
+
+TEST(map_heterogeneous, case1) {
+  s21::map<std::string, int> s21_map = {{"alpha", 1}, {"beta", 2}};
+  std::string_view view = "beta";
+  const char *str = "alpha";
+  EXPECT_TRUE(s21_map.contains(view));
+  EXPECT_TRUE(s21_map.contains(str));
+  EXPECT_FALSE(s21_map.contains(std::string_view("gamma")));
+  EXPECT_EQ(s21_map.at(view), 2);
+  EXPECT_EQ(s21_map.find(str)->second, 1);
+  EXPECT_EQ(s21_map.lower_bound(std::string_view("b"))->first, "beta");
+  EXPECT_EQ(s21_map.count(std::string_view("alpha")), 1U);
+  EXPECT_THROW(s21_map.at(std::string_view("gamma")), std::out_of_range);
+
+  s21::map<CountedKey, int> s21_map_counted = {{"one", 1}, {"two", 2}};
+  CountedKey::created = 0;
+  EXPECT_EQ(s21_map_counted.at(std::string_view("two")), 2);
+  EXPECT_TRUE(s21_map_counted.contains(std::string_view("one")));
+  EXPECT_EQ(s21_map_counted.upper_bound(std::string_view("one"))->second, 2);
+  EXPECT_EQ(CountedKey::created, 0);
+}
+
+TEST(map_compare, case1) {
+  s21::map<int, char, std::greater<int>> s21_map = {{1, 'a'}, {3, 'c'}};
+  s21_map.insert(2, 'b');
+  std::string values;
+  for (auto it = s21_map.begin(); it != s21_map.end(); ++it)
+    values += it->second;
+  EXPECT_EQ(values, "cba");
+  EXPECT_EQ(s21_map.lower_bound(2)->second, 'b');
+  EXPECT_EQ(s21_map.upper_bound(2)->second, 'a');
+  EXPECT_TRUE(s21_map.key_comp()(3, 1));
+}
+
+// Counts the calls a comparator receives.
+struct CountingLess {
+  int *calls;
+  bool operator()(int a, int b) const {
+    ++*calls;
+    return a < b;
+  }
+};
+
+struct CountingThreeWay {
+  int *calls;
+  using is_transparent = void;
+  bool operator()(int a, int b) const {
+    ++*calls;
+    return a < b;
+  }
+  int compare(int a, int b) const {
+    ++*calls;
+    return a < b ? -1 : (b < a ? 1 : 0);
+  }
+};
+
+TEST(map_compare, case2) {
+  // A balanced tree of 1023 keys has about nine levels on an average path;
+  // two comparisons per level would cost close to twenty per lookup.
+  int calls = 0;
+  s21::map<int, int, CountingLess> s21_map(CountingLess{&calls});
+  for (int i = 0; i < 1023; ++i) s21_map.insert((i * 389) % 1023, i);
+  calls = 0;
+  for (int i = 0; i < 1023; ++i) EXPECT_TRUE(s21_map.contains(i));
+  EXPECT_LT(calls, 1023 * 13);
+
+  int three_way_calls = 0;
+  s21::map<int, int, CountingThreeWay> s21_map_three_way(
+      CountingThreeWay{&three_way_calls});
+  for (int i = 0; i < 1023; ++i)
+    s21_map_three_way.insert((i * 389) % 1023, i);
+  three_way_calls = 0;
+  for (int i = 0; i < 1023; ++i)
+    EXPECT_EQ(s21_map_three_way.at(i), s21_map.at(i));
+  EXPECT_LT(three_way_calls, 1023 * 12);
+}
+
+TEST(map_compare, case3) {
+  s21::map<std::string, int, s21::three_way_less> s21_map = {
+      {"prefix/common/b", 2}, {"prefix/common/a", 1}, {"prefix/common/c", 3}};
+  EXPECT_EQ(s21_map.begin()->second, 1);
+  EXPECT_EQ(s21_map.at(std::string_view("prefix/common/b")), 2);
+  EXPECT_EQ(s21_map.at("prefix/common/c"), 3);
+  EXPECT_FALSE(s21_map.contains("prefix/common/d"));
+  EXPECT_EQ(s21::three_way_less().compare(std::string("ab"), "abc"), -1);
+  EXPECT_EQ(s21::three_way_less().compare("abd", std::string("abc")), 1);
+  EXPECT_EQ(s21::three_way_less().compare(2.5, 2.5), 0);
+}
+
+TEST(map_iterator, case2) {
+  s21::map<int, int> s21_map;
+  int steps = 0;
+  for (auto it = s21_map.begin(); it != s21_map.end(); ++it) ++steps;
+  EXPECT_EQ(steps, 0);
+
+  for (int i = 0; i < 100; ++i) s21_map.insert(i, i * i);
+  auto last = --s21_map.end();
+  EXPECT_EQ(last->first, 99);
+  EXPECT_EQ(++last, s21_map.end());
+  EXPECT_EQ(std::distance(s21_map.begin(), s21_map.end()), 100);
+
+  int expected = 99;
+  for (auto it = s21_map.end(); it != s21_map.begin();) {
+    --it;
+    EXPECT_EQ(it->first, expected--);
+  }
+  EXPECT_EQ(expected, -1);
+
+  auto it = s21_map.begin();
+  it += 100;
+  EXPECT_EQ(it, s21_map.end());
+  it -= 10;
+  EXPECT_EQ(it->first, 90);
+}
+
+TEST(map_hint, case1) {
+  int calls = 0;
+  s21::map<int, int, CountingLess> s21_map(CountingLess{&calls});
+  for (int i = 0; i < 1000; ++i) s21_map.insert(s21_map.end(), {i, i});
+  EXPECT_EQ(s21_map.size(), 1000U);
+  EXPECT_LE(calls, 1000);
+
+  auto it = s21_map.insert(s21_map.find(500), {500, 0});
+  EXPECT_EQ(it->second, 500);
+  it = s21_map.insert(s21_map.begin(), {2000, 1});
+  EXPECT_EQ(it->first, 2000);
+  it = s21_map.emplace_hint(s21_map.begin(), -1, 7);
+  EXPECT_EQ(s21_map.begin(), it);
+  EXPECT_EQ(s21_map.size(), 1002U);
+}
+
+TEST(map_hint, case2) {
+  s21::map<int, int> s21_map = {{5, 5}, {1, 1}};
+  std::vector<std::pair<int, int>> batch = {{2, 2}, {3, 3}, {9, 9}, {0, 0},
+                                            {5, 50}, {10, 10}};
+  s21_map.append_sorted(batch.begin(), batch.end());
+  EXPECT_EQ(s21_map.size(), 7U);
+  EXPECT_EQ(s21_map.at(5), 5);
+  int expected[] = {0, 1, 2, 3, 5, 9, 10};
+  int i = 0;
+  for (auto it = s21_map.begin(); it != s21_map.end(); ++it)
+    EXPECT_EQ(it->first, expected[i++]);
+  EXPECT_EQ(s21_map.rank(9), 5U);
+}
+
+struct CopyCounted {
+  static int copies;
+  int value;
+  explicit CopyCounted(int v) : value(v) {}
+  CopyCounted(const CopyCounted &other) : value(other.value) { ++copies; }
+  CopyCounted(CopyCounted &&other) noexcept : value(other.value) {}
+  CopyCounted &operator=(const CopyCounted &other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  CopyCounted &operator=(CopyCounted &&other) noexcept {
+    value = other.value;
+    return *this;
+  }
+};
+int CopyCounted::copies = 0;
+
+TEST(map_emplace, case1) {
+  s21::map<int, CopyCounted> s21_map;
+  CopyCounted::copies = 0;
+  EXPECT_TRUE(s21_map.emplace(1, CopyCounted(10)).second);
+  EXPECT_TRUE(s21_map.try_emplace(2, 20).second);
+  EXPECT_TRUE(s21_map.insert({3, CopyCounted(30)}).second);
+  EXPECT_TRUE(s21_map.emplace(std::piecewise_construct,
+                              std::forward_as_tuple(4),
+                              std::forward_as_tuple(40))
+                  .second);
+  EXPECT_FALSE(s21_map.emplace(1, CopyCounted(11)).second);
+  EXPECT_FALSE(s21_map.try_emplace(2, 21).second);
+  EXPECT_EQ(CopyCounted::copies, 0);
+  EXPECT_EQ(s21_map.size(), 4U);
+  EXPECT_EQ(s21_map.at(1).value, 10);
+  EXPECT_EQ(s21_map.at(2).value, 20);
+  EXPECT_EQ(s21_map.at(4).value, 40);
+}
+
+TEST(map_emplace, case2) {
+  s21::map<std::string, std::unique_ptr<int>> s21_map;
+  s21_map.try_emplace("one", new int(1));
+  s21_map.emplace("two", std::make_unique<int>(2));
+  s21_map.insert({"three", std::make_unique<int>(3)});
+  s21_map["four"] = std::make_unique<int>(4);
+
+  auto ptr = std::make_unique<int>(5);
+  auto res = s21_map.try_emplace("one", std::move(ptr));
+  EXPECT_FALSE(res.second);
+  EXPECT_NE(ptr, nullptr);
+
+  EXPECT_EQ(s21_map.size(), 4U);
+  EXPECT_EQ(*s21_map.at("one"), 1);
+  EXPECT_EQ(*s21_map.at("three"), 3);
+  EXPECT_EQ(*s21_map["four"], 4);
+}
+
+TEST(map_extract, case1) {
+  s21::map<int, std::string> tenant1 = {{1, "a"}, {2, "b"}, {3, "c"}};
+  s21::map<int, std::string> tenant2 = {{10, "x"}};
+  const std::string *address = &tenant1.at(2);
+
+  auto node = tenant1.extract(2);
+  EXPECT_FALSE(node.empty());
+  EXPECT_EQ(node.key(), 2);
+  EXPECT_EQ(node.mapped(), "b");
+  EXPECT_EQ(tenant1.size(), 2U);
+  EXPECT_FALSE(tenant1.contains(2));
+
+  auto res = tenant2.insert(std::move(node));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_TRUE(res.node.empty());
+  EXPECT_EQ(res.position->first, 2);
+  EXPECT_EQ(&res.position->second, address);
+  EXPECT_EQ(tenant2.size(), 2U);
+
+  EXPECT_TRUE(tenant1.extract(42).empty());
+  EXPECT_TRUE(tenant1.extract(tenant1.end()).empty());
+}
+
+TEST(map_extract, case2) {
+  s21::map<int, std::string> s21_map = {{1, "a"}, {2, "b"}, {3, "c"}};
+  auto node = s21_map.extract(s21_map.begin());
+  node.key() = 5;
+  auto res = s21_map.insert(std::move(node));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_EQ(s21_map.size(), 3U);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 5);
+  EXPECT_EQ(s21_map.at(5), "a");
+
+  node = s21_map.extract(5);
+  node.key() = 2;
+  node.mapped() = "z";
+  res = s21_map.insert(std::move(node));
+  EXPECT_FALSE(res.inserted);
+  EXPECT_EQ(res.position->second, "b");
+  EXPECT_FALSE(res.node.empty());
+  EXPECT_EQ(res.node.mapped(), "z");
+
+  res.node.key() = 4;
+  auto it = s21_map.insert(s21_map.end(), std::move(res.node));
+  EXPECT_EQ(it->first, 4);
+  EXPECT_EQ(s21_map.size(), 3U);
+  int expected[] = {2, 3, 4};
+  int i = 0;
+  for (auto &elem : s21_map) EXPECT_EQ(elem.first, expected[i++]);
+}
+
+TEST(map_extract, case3) {
+  using pool_map =
+      s21::map<int, std::string, std::less<>,
+               s21::node_pool_allocator<std::pair<const int, std::string>>>;
+  pool_map tenant1 = {{1, "a"}, {2, "b"}};
+  pool_map tenant2;
+  EXPECT_FALSE(tenant1.get_allocator() == tenant2.get_allocator());
+
+  auto res = tenant2.insert(tenant1.extract(1));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_EQ(tenant2.at(1), "a");
+  tenant1.clear();
+  EXPECT_EQ(tenant2.size(), 1U);
+  EXPECT_EQ(tenant2.at(1), "a");
+}
+
+TEST(map_erase_range, case1) {
+  s21::map<int, int> s21_map;
+  std::map<int, int> std_map;
+  for (int i = 0; i < 1000; ++i) {
+    s21_map.insert(i, i);
+    std_map.insert({i, i});
+  }
+  auto it = s21_map.erase(s21_map.find(100), s21_map.find(300));
+  std_map.erase(std_map.find(100), std_map.find(300));
+  EXPECT_EQ(it->first, 300);
+  EXPECT_EQ(s21_map.erase_range(900, 2000), 100U);
+  std_map.erase(std_map.lower_bound(900), std_map.end());
+  EXPECT_EQ(s21_map.erase_range(50, 50), 0U);
+  EXPECT_EQ(s21_map.erase(s21_map.begin(), s21_map.begin()), s21_map.begin());
+
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  EXPECT_TRUE(std::equal(std_map.begin(), std_map.end(), s21_map.begin()));
+  EXPECT_EQ(s21_map.nth(100)->first, 300);
+  EXPECT_EQ(s21_map.rank(899), 699U);
+
+  s21_map.erase(s21_map.begin(), s21_map.end());
+  EXPECT_TRUE(s21_map.empty());
+}
+
+TEST(map_erase_range, case2) {
+  using unranked_tree =
+      s21::Tree<int, int, std::less<>,
+                std::allocator<std::pair<const int, int>>, false>;
+  unranked_tree s21_tree;
+  for (int i = 0; i < 1000; ++i) s21_tree.insert({i, i});
+
+  auto it = s21_tree.erase(s21_tree.find(100), s21_tree.find(300));
+  EXPECT_EQ(it->first, 300);
+  EXPECT_EQ(s21_tree.size(), 800U);
+  EXPECT_EQ(s21_tree.erase_range(900, 2000), 100U);
+  EXPECT_EQ(s21_tree.erase_range(50, 50), 0U);
+  unranked_tree expired = s21_tree.extract_range(0, 10);
+  EXPECT_EQ(expired.size(), 10U);
+  EXPECT_EQ(s21_tree.size(), 690U);
+  EXPECT_EQ(s21_tree.begin()->first, 10);
+  EXPECT_EQ(std::prev(s21_tree.end())->first, 899);
+  EXPECT_FALSE(s21_tree.contains(200));
+}
+
+TEST(map_erase_range, case3) {
+  s21::map<int, int> s21_map;
+  for (int i = 0; i < 1000; ++i) s21_map.insert(i, i);
+
+  // Three positions are unlinked one by one, every other one of the rest
+  // through a rebuild.
+  std::vector<s21::map<int, int>::const_iterator> positions = {
+      s21_map.find(10), s21_map.find(500), s21_map.find(999)};
+  EXPECT_EQ(s21_map.erase_many(positions), 3U);
+  positions.clear();
+  for (auto it = s21_map.begin(); it != s21_map.end(); ++it)
+    if (it->first % 2) positions.push_back(it);
+  EXPECT_EQ(s21_map.erase_many(positions), 499U);
+
+  ASSERT_EQ(s21_map.size(), 498U);
+  int key = 0;
+  for (const auto &elem : s21_map) {
+    if (key == 10 || key == 500) key += 2;
+    EXPECT_EQ(elem.first, key);
+    key += 2;
+  }
+  EXPECT_EQ(s21_map.nth(300)->first, 604);
+  EXPECT_EQ(s21_map.rank(604), 300U);
+  EXPECT_EQ(s21_map.erase_many({}), 0U);
+}
+
+TEST(map_extract_range, case1) {
+  s21::map<int, std::string> s21_map = {
+      {1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}, {5, "e"}};
+  const std::string *address = &s21_map.at(3);
+  auto expired = s21_map.extract_range(2, 4);
+  EXPECT_EQ(expired.size(), 2U);
+  EXPECT_EQ(&expired.at(3), address);
+  EXPECT_EQ(expired.begin()->first, 2);
+  EXPECT_EQ(s21_map.size(), 3U);
+  EXPECT_FALSE(s21_map.contains(3));
+  EXPECT_EQ(std::prev(s21_map.end())->first, 5);
+  EXPECT_TRUE(s21_map.extract_range(4, 2).empty());
+}
+
+// Orders ints either way round, and has no default order to fall back on.
+struct DirectedLess {
+  explicit DirectedLess(bool descending) : descending(descending) {}
+  bool operator()(int a, int b) const { return descending ? b < a : a < b; }
+  bool descending;
+};
+
+TEST(map_extract_range, case2) {
+  using pool_map =
+      s21::map<int, int, DirectedLess,
+               s21::node_pool_allocator<std::pair<const int, int>>>;
+  pool_map s21_map(DirectedLess(true));
+  for (int i = 0; i < 100; ++i) s21_map.insert(i, i);
+
+  auto expired = s21_map.extract_range(80, 60);
+  EXPECT_EQ(expired.size(), 20U);
+  EXPECT_EQ(expired.begin()->first, 80);
+  EXPECT_TRUE(expired.key_comp().descending);
+  EXPECT_TRUE(expired.get_allocator() == s21_map.get_allocator());
+
+  EXPECT_EQ(s21_map.erase_range(99, 90), 9U);
+  s21_map.erase(s21_map.find(40), s21_map.find(20));
+  ASSERT_EQ(s21_map.size(), 51U);
+  EXPECT_EQ(s21_map.begin()->first, 90);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 0);
+  EXPECT_FALSE(s21_map.contains(30));
+  EXPECT_TRUE(s21_map.contains(20));
 }
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include "../s21_allocator.h"
 #include "../s21_multiset.h"
 
 TEST(multiset, allcase) {
@@ -23,3 +24,201 @@ TEST(multiset, allcase) {
   my_multiset.erase(it);
   EXPECT_EQ(my_multiset.size(), 8U);
 }
+
+TEST(multiset, size) {
+  s21::multiset<int> my_multiset;
+  for (int i = 0; i < 50; ++i) my_multiset.Insert(i % 5);
+  EXPECT_EQ(my_multiset.size(), 50U);
+
+  s21::multiset<int> my_multiset_moved(std::move(my_multiset));
+  EXPECT_EQ(my_multiset_moved.size(), 50U);
+  EXPECT_EQ(my_multiset.size(), 0U);
+  EXPECT_TRUE(my_multiset.empty());
+}
+
+TEST(multiset, equal_range) {
+  s21::multiset<int> my_multiset;
+  for (int i = 0; i < 30; ++i) my_multiset.Insert(i % 3);
+
+  auto range = my_multiset.equal_range(1);
+  int count = 0;
+  for (auto it = range.first; it != range.second; ++it) {
+    EXPECT_EQ(*it, 1);
+    ++count;
+  }
+  EXPECT_EQ(count, 10);
+  EXPECT_EQ(*my_multiset.find(2), 2);
+  EXPECT_EQ(*my_multiset.lower_bound(1), 1);
+  EXPECT_EQ(*my_multiset.upper_bound(0), 1);
+}
+
+TEST(multiset, order_statistics) {
+  s21::multiset<int> latencies;
+  for (int i = 0; i < 100; ++i) latencies.Insert(i % 10);
+
+  EXPECT_EQ(*latencies.nth(49), 4);
+  EXPECT_EQ(*latencies.nth(99), 9);
+  EXPECT_EQ(latencies.rank(5), 50U);
+}
+
+TEST(multiset, constructors) {
+  s21::multiset<int> from_list = {3, 1, 3, 2, 1, 3};
+  EXPECT_EQ(from_list.size(), 6U);
+  EXPECT_EQ(from_list.rank(3), 3U);
+
+  std::vector<int> sorted = {1, 1, 2, 2, 2, 5};
+  s21::multiset<int> from_range(sorted.begin(), sorted.end());
+  EXPECT_EQ(from_range.size(), 6U);
+  EXPECT_EQ(*from_range.nth(4), 2);
+
+  from_range.assign(sorted.begin(), sorted.begin() + 2);
+  EXPECT_EQ(from_range.size(), 2U);
+
+  s21::multiset<int> copy = from_list;
+  EXPECT_EQ(copy.size(), 6U);
+}
+
+TEST(multiset, algebra) {
+  s21::multiset<int> lhs = {1, 1, 1, 2, 3};
+  s21::multiset<int> rhs = {1, 1, 3, 3, 4};
+
+  s21::multiset<int> united = lhs;
+  united.unite(rhs);
+  EXPECT_EQ(united.size(), 7U);
+  EXPECT_EQ(united.rank(2), 3U);
+
+  s21::multiset<int> common = lhs;
+  common.intersect(rhs);
+  EXPECT_EQ(common.size(), 3U);
+  EXPECT_EQ(*std::prev(common.end()), 3);
+
+  s21::multiset<int> difference = lhs;
+  difference.subtract(rhs);
+  EXPECT_EQ(difference.size(), 2U);
+  EXPECT_EQ(*difference.begin(), 1);
+
+  lhs.merge(rhs);
+  EXPECT_EQ(lhs.size(), 10U);
+  EXPECT_EQ(lhs.rank(2), 5U);
+  EXPECT_TRUE(rhs.empty());
+}
+
+TEST(multiset, split_join) {
+  s21::multiset<int> lhs = {1, 2, 2, 2, 3};
+  s21::multiset<int> rhs;
+
+  lhs.split(2, rhs);
+  EXPECT_EQ(lhs.size(), 1U);
+  EXPECT_EQ(rhs.size(), 4U);
+  EXPECT_EQ(rhs.rank(3), 3U);
+
+  s21::multiset<int> twos = {1, 1};
+  twos.join(lhs);
+  EXPECT_EQ(twos.size(), 3U);
+  EXPECT_TRUE(lhs.empty());
+}
+
+TEST(multiset, allocator) {
+  using pool_multiset =
+      s21::multiset<int, std::less<>, s21::node_pool_allocator<int>>;
+  pool_multiset pooled;
+  for (int i = 0; i < 500; ++i) pooled.Insert(i % 5);
+  EXPECT_EQ(pooled.size(), 500U);
+  EXPECT_EQ(pooled.rank(4), 400U);
+
+  pool_multiset moved(std::move(pooled));
+  EXPECT_EQ(moved.size(), 500U);
+  EXPECT_TRUE(pooled.empty());
+}
+
+TEST(multiset, compare) {
+  s21::multiset<std::string, std::greater<>> s21_multiset = {"b", "a", "c",
+                                                             "b"};
+  std::string keys;
+  for (auto it = s21_multiset.begin(); it != s21_multiset.end(); ++it)
+    keys += *it;
+  EXPECT_EQ(keys, "cbba");
+  s21_multiset.Insert("b");
+  EXPECT_EQ(s21_multiset.rank("b"), 1U);
+  EXPECT_EQ(*s21_multiset.upper_bound("b"), "a");
+
+  s21::multiset<std::string, std::greater<>> s21_multiset_other = {"d", "b"};
+  s21_multiset.merge(s21_multiset_other);
+  EXPECT_EQ(s21_multiset.size(), 7U);
+  EXPECT_EQ(*s21_multiset.begin(), "d");
+}
+
+TEST(multiset, hint) {
+  s21::multiset<int> s21_multiset;
+  std::vector<int> sorted = {1, 1, 2, 3, 3, 3, 7};
+  s21_multiset.append_sorted(sorted.begin(), sorted.end());
+  s21_multiset.insert(s21_multiset.end(), 7);
+  s21_multiset.insert(s21_multiset.begin(), 3);
+  s21_multiset.emplace_hint(s21_multiset.find(2), 1);
+  EXPECT_EQ(s21_multiset.size(), 10U);
+  EXPECT_EQ(s21_multiset.rank(2), 3U);
+  EXPECT_EQ(s21_multiset.rank(7), 8U);
+  auto range = s21_multiset.equal_range(3);
+  int threes = 0;
+  for (auto it = range.first; it != range.second; ++it) ++threes;
+  EXPECT_EQ(threes, 4);
+}
+
+TEST(multiset, insert) {
+  s21::multiset<std::string> s21_multiset;
+  std::string key = "x";
+  EXPECT_TRUE(s21_multiset.insert(key).second);
+  EXPECT_TRUE(s21_multiset.insert(key).second);
+  EXPECT_TRUE(s21_multiset.insert(std::string("x")).second);
+  s21_multiset.insert(s21_multiset.end(), key);
+  EXPECT_EQ(s21_multiset.count(key), 4U);
+  EXPECT_EQ(s21_multiset.size(), 4U);
+}
+
+TEST(multiset, count) {
+  s21::multiset<int> s21_multiset = {4, 1, 4, 2, 4, 3};
+  EXPECT_EQ(s21_multiset.count(4), 3U);
+  EXPECT_EQ(s21_multiset.count(5), 0U);
+  EXPECT_EQ(s21_multiset.erase(4), 3U);
+  EXPECT_EQ(s21_multiset.erase(4), 0U);
+  EXPECT_EQ(s21_multiset.size(), 3U);
+  s21_multiset.erase(s21_multiset.begin());
+  EXPECT_EQ(*s21_multiset.begin(), 2);
+}
+
+TEST(multiset, emplace) {
+  s21::multiset<std::string> s21_multiset;
+  s21_multiset.emplace(2, 'x');
+  s21_multiset.emplace("xx");
+  auto inserted = s21_multiset.insert_many("a", "xx", std::string(1, 'b'));
+  EXPECT_EQ(inserted.size(), 3U);
+  EXPECT_TRUE(inserted[1].second);
+  EXPECT_EQ(s21_multiset.size(), 5U);
+  EXPECT_EQ(s21_multiset.count("xx"), 3U);
+}
+
+TEST(multiset, extract) {
+  s21::multiset<int> s21_multiset = {1, 2, 2, 3};
+  s21::multiset<int> s21_multiset_other = {2};
+  s21_multiset_other.insert(s21_multiset.extract(2));
+  auto it = s21_multiset_other.insert(s21_multiset_other.end(),
+                                      s21_multiset.extract(2));
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(s21_multiset.size(), 2U);
+  EXPECT_EQ(s21_multiset_other.count(2), 3U);
+  EXPECT_TRUE(s21_multiset.extract(2).empty());
+}
+
+TEST(multiset, erase_range) {
+  s21::multiset<int> s21_multiset = {1, 2, 2, 2, 3, 3, 4};
+  auto extracted = s21_multiset.extract_range(2, 4);
+  EXPECT_EQ(extracted.size(), 5U);
+  EXPECT_EQ(extracted.count(2), 3U);
+  EXPECT_EQ(s21_multiset.size(), 2U);
+  s21_multiset.merge(extracted);
+  auto first = s21_multiset.find(2);
+  ++first;
+  s21_multiset.erase(first, s21_multiset.upper_bound(3));
+  EXPECT_EQ(s21_multiset.size(), 3U);
+  EXPECT_EQ(s21_multiset.count(2), 1U);
+}
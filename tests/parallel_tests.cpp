@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "../s21_map.h"
+#include "../s21_multiset.h"
+#include "../s21_parallel.h"
+#include "../s21_set.h"
+
+TEST(parallel_for_each, case1) {
+  s21::map<int, int> s21_map;
+  for (int i = 0; i < 50000; ++i) s21_map.insert(i, i);
+  s21::parallel_for_each(
+      s21_map, [](std::pair<const int, int> &elem) { elem.second *= 2; }, 4);
+  for (int i = 0; i < 50000; i += 997) EXPECT_EQ(s21_map.at(i), 2 * i);
+
+  s21::map<int, int> s21_map_small = {{1, 1}};
+  s21::parallel_for_each(
+      s21_map_small, [](std::pair<const int, int> &elem) { ++elem.second; });
+  EXPECT_EQ(s21_map_small.at(1), 2);
+}
+
+TEST(parallel_reduce, case1) {
+  s21::set<int> s21_set;
+  for (int i = 1; i <= 30000; ++i) s21_set.insert(i);
+  long long sum = s21::parallel_reduce(
+      s21_set, 0LL, [](long long a, long long b) { return a + b; },
+      [](int key) { return static_cast<long long>(key); }, 8);
+  EXPECT_EQ(sum, 30000LL * 30001 / 2);
+
+  // Concatenation is not commutative; ranges still combine in key order.
+  s21::set<int> s21_set_digits;
+  for (int i = 0; i < 20000; ++i) s21_set_digits.insert(i);
+  std::string digits = s21::parallel_reduce(
+      s21_set_digits, std::string(">"),
+      [](std::string a, const std::string &b) { return a + b; },
+      [](int key) { return std::string(1, char('0' + key % 10)); }, 3);
+  ASSERT_EQ(digits.size(), 20001U);
+  for (size_t i = 1; i < digits.size(); ++i)
+    EXPECT_EQ(digits[i], char('0' + (i - 1) % 10));
+
+  s21::set<int> s21_set_empty;
+  EXPECT_EQ(s21::parallel_reduce(
+                s21_set_empty, 7, [](int a, int b) { return a + b; },
+                [](int key) { return key; }),
+            7);
+}
+
+TEST(parallel_count_if, case1) {
+  s21::multiset<int> s21_multiset;
+  for (int i = 0; i < 40000; ++i) s21_multiset.Insert(i % 100);
+  EXPECT_EQ(s21::parallel_count_if(s21_multiset,
+                                   [](int key) { return key < 10; }),
+            4000U);
+  EXPECT_THROW(s21::parallel_count_if(
+                   s21_multiset,
+                   [](int key) -> bool {
+                     if (key == 99) throw std::runtime_error("stop");
+                     return false;
+                   },
+                   4),
+               std::runtime_error);
+}
+
+TEST(parallel_count_if, case2) {
+  // Without order statistics the ranges are whole subtrees.
+  s21::Tree<int, int, std::less<>, std::allocator<std::pair<const int, int>>,
+            false>
+      s21_tree;
+  for (int i = 0; i < 50000; ++i) s21_tree.insert({i, i});
+  EXPECT_EQ(s21::parallel_count_if(
+                s21_tree,
+                [](const std::pair<const int, int> &elem) {
+                  return elem.first % 2 == 0;
+                },
+                4),
+            25000U);
+}
+
+TEST(parallel_erase_if, case1) {
+  s21::map<int, int> s21_map;
+  for (int i = 0; i < 40000; ++i) s21_map.insert(i, i % 7);
+  size_t erased = s21::parallel_erase_if(
+      s21_map,
+      [](const std::pair<const int, int> &elem) { return elem.second == 0; },
+      4);
+  EXPECT_EQ(erased, 5715U);
+  EXPECT_EQ(s21_map.size(), 40000U - 5715U);
+  EXPECT_FALSE(s21_map.contains(0));
+  EXPECT_TRUE(s21_map.contains(1));
+  int previous = -1;
+  for (const auto &elem : s21_map) {
+    EXPECT_LT(previous, elem.first);
+    EXPECT_NE(elem.second, 0);
+    previous = elem.first;
+  }
+}
+
+TEST(parallel_erase_if, case2) {
+  s21::multiset<int> s21_multiset;
+  for (int i = 0; i < 40000; ++i) s21_multiset.insert(i / 2);
+  size_t erased = s21::parallel_erase_if(
+      s21_multiset, [](int key) { return key % 5000 == 0; }, 4);
+  EXPECT_EQ(erased, 8U);
+  EXPECT_EQ(s21_multiset.size(), 39992U);
+  EXPECT_EQ(s21_multiset.count(5000), 0U);
+  EXPECT_EQ(*s21_multiset.nth(0), 1);
+  EXPECT_EQ(s21_multiset.rank(5001), 9998U);
+
+  erased = s21::parallel_erase_if(
+      s21_multiset, [](int key) { return key % 2 == 0; }, 4);
+  EXPECT_EQ(erased, 19992U);
+  EXPECT_EQ(s21_multiset.size(), 20000U);
+  EXPECT_EQ(*s21_multiset.nth(1), 1);
+  EXPECT_EQ(*s21_multiset.nth(2), 3);
+  EXPECT_EQ(s21_multiset.rank(5001), 5000U);
+}
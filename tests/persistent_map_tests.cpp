@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_persistent_map.h"
+
+TEST(persistent_map_constructor, case1) {
+  s21::persistent_map<int, std::string> s21_map = {
+      {2, "b"}, {1, "a"}, {3, "c"}, {1, "z"}};
+  EXPECT_EQ(s21_map.size(), 3U);
+  EXPECT_EQ(s21_map.at(1), "a");
+  EXPECT_EQ(s21_map.begin()->first, 1);
+  EXPECT_EQ(std::prev(s21_map.end())->first, 3);
+  EXPECT_THROW(s21_map.at(4), std::out_of_range);
+
+  s21::persistent_map<int, std::string> s21_map_empty;
+  EXPECT_TRUE(s21_map_empty.begin() == s21_map_empty.end());
+}
+
+TEST(persistent_map_snapshot, case1) {
+  s21::persistent_map<int, std::string> s21_map = {{1, "a"}, {2, "b"}};
+  auto version1 = s21_map.snapshot();
+
+  EXPECT_TRUE(s21_map.insert(3, "c").second);
+  EXPECT_FALSE(s21_map.insert(1, "x").second);
+  EXPECT_FALSE(s21_map.insert_or_assign(2, "B").second);
+  auto version2 = s21_map.snapshot();
+  EXPECT_EQ(s21_map.erase(1), 1U);
+  EXPECT_EQ(s21_map.erase(1), 0U);
+
+  EXPECT_EQ(version1.size(), 2U);
+  EXPECT_EQ(version1.at(2), "b");
+  EXPECT_FALSE(version1.contains(3));
+  EXPECT_EQ(version2.size(), 3U);
+  EXPECT_EQ(version2.at(1), "a");
+  EXPECT_EQ(version2.at(2), "B");
+  EXPECT_EQ(s21_map.size(), 2U);
+  EXPECT_FALSE(s21_map.contains(1));
+  EXPECT_EQ(s21_map.at(3), "c");
+}
+
+TEST(persistent_map_modifiers, case1) {
+  s21::persistent_map<int, int> s21_map;
+  std::map<int, int> std_map;
+  std::vector<s21::persistent_map<int, int>> versions;
+  std::vector<std::map<int, int>> std_versions;
+  for (int i = 0; i < 4000; ++i) {
+    int key = (i * 7919) % 1000;
+    if (i % 3 == 2) {
+      EXPECT_EQ(s21_map.erase(key), std_map.erase(key));
+    } else {
+      EXPECT_EQ(s21_map.insert_or_assign(key, i).second,
+                std_map.insert_or_assign(key, i).second);
+    }
+    if (i % 500 == 0) {
+      versions.push_back(s21_map.snapshot());
+      std_versions.push_back(std_map);
+    }
+  }
+  versions.push_back(s21_map);
+  std_versions.push_back(std_map);
+  for (size_t v = 0; v < versions.size(); ++v) {
+    ASSERT_EQ(versions[v].size(), std_versions[v].size());
+    EXPECT_TRUE(std::equal(std_versions[v].begin(), std_versions[v].end(),
+                           versions[v].begin()));
+  }
+
+  auto it = s21_map.lower_bound(500);
+  EXPECT_EQ(it->first, std_map.lower_bound(500)->first);
+  it = s21_map.upper_bound(500);
+  EXPECT_EQ(it->first, std_map.upper_bound(500)->first);
+  EXPECT_EQ((--it)->first, std::prev(std_map.upper_bound(500))->first);
+  EXPECT_TRUE(s21_map.lower_bound(1000) == s21_map.end());
+}
+
+TEST(persistent_map_threads, case1) {
+  s21::persistent_map<int, int> s21_map;
+  for (int i = 0; i < 1000; ++i) s21_map.insert(i, i);
+  auto snapshot = s21_map.snapshot();
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([snapshot] {
+      for (int round = 0; round < 20; ++round) {
+        int expected = 0;
+        for (const auto &elem : snapshot) EXPECT_EQ(elem.first, expected++);
+        EXPECT_EQ(expected, 1000);
+      }
+    });
+  }
+  for (int i = 0; i < 1000; ++i) {
+    s21_map.erase(i);
+    s21_map.insert(i + 1000, i);
+  }
+  for (std::thread &reader : readers) reader.join();
+  EXPECT_EQ(s21_map.begin()->first, 1000);
+  EXPECT_EQ(snapshot.begin()->first, 0);
+}
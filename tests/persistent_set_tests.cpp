@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <string>
+
+#include "../s21_persistent_set.h"
+
+TEST(persistent_set_constructor, case1) {
+  std::vector<std::string> words = {"delta", "alpha", "charlie", "alpha"};
+  s21::persistent_set<std::string> s21_set(words.begin(), words.end());
+  EXPECT_EQ(s21_set.size(), 3U);
+  EXPECT_EQ(*s21_set.begin(), "alpha");
+
+  s21::persistent_set<std::string> s21_set_copy;
+  s21_set_copy = s21_set;
+  s21_set.clear();
+  EXPECT_EQ(s21_set_copy.size(), 3U);
+  EXPECT_EQ(s21_set_copy.count("charlie"), 1U);
+}
+
+TEST(persistent_set_snapshot, case1) {
+  s21::persistent_set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 2000; ++i) {
+    EXPECT_EQ(s21_set.insert(i % 700).second, std_set.insert(i % 700).second);
+  }
+  auto snapshot = s21_set.snapshot();
+  for (int i = 0; i < 700; i += 2) s21_set.erase(i);
+
+  ASSERT_EQ(snapshot.size(), std_set.size());
+  EXPECT_TRUE(std::equal(std_set.begin(), std_set.end(), snapshot.begin()));
+  EXPECT_EQ(s21_set.size(), 350U);
+  EXPECT_EQ(*s21_set.begin(), 1);
+  EXPECT_EQ(*std::prev(s21_set.end()), 699);
+  EXPECT_TRUE(s21_set.find(4) == s21_set.end());
+  EXPECT_EQ(*snapshot.find(4), 4);
+}
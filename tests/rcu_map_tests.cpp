@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_rcu_map.h"
+
+TEST(rcu_map_writers, case1) {
+  s21::rcu_map<int, std::string> s21_map(
+      s21::map<int, std::string>{{1, "a"}, {2, "b"}});
+  s21::rcu_map<int, std::string>::reader reader(s21_map);
+  EXPECT_EQ(*reader.find(1), "a");
+
+  EXPECT_TRUE(s21_map.insert(3, "c"));
+  EXPECT_FALSE(s21_map.insert(3, "x"));
+  EXPECT_FALSE(s21_map.insert_or_assign(1, "A"));
+  EXPECT_EQ(s21_map.erase(2), 1U);
+  s21_map.update([](s21::map<int, std::string> &next) {
+    next.insert(4, "d");
+    next.erase(3);
+  });
+
+  EXPECT_EQ(*reader.find(1), "A");
+  EXPECT_FALSE(reader.contains(2));
+  EXPECT_FALSE(reader.find(3).has_value());
+  EXPECT_EQ(reader.read([](const s21::map<int, std::string> &version) {
+    return version.size();
+  }),
+            2U);
+  // No read is running, so every old version has been freed already.
+  EXPECT_EQ(s21_map.retired(), 0U);
+
+  s21_map.store(s21::map<int, std::string>{{9, "z"}});
+  EXPECT_EQ(*reader.find(9), "z");
+  EXPECT_FALSE(reader.contains(1));
+}
+
+TEST(rcu_map_writers, case2) {
+  s21::rcu_map<int, int> s21_map;
+  std::atomic<bool> reading(false);
+  std::atomic<bool> written(false);
+  bool was_empty = false;
+  // A read on another thread stays open while this one writes.
+  std::thread reader_thread([&] {
+    s21::rcu_map<int, int>::reader reader(s21_map);
+    reader.read([&](const s21::map<int, int> &version) {
+      reading.store(true);
+      while (!written.load()) std::this_thread::yield();
+      was_empty = version.empty();
+    });
+  });
+  while (!reading.load()) std::this_thread::yield();
+  s21_map.insert(1, 1);
+  s21_map.insert(2, 2);
+  // The running read keeps the versions it may be looking at.
+  EXPECT_EQ(s21_map.retired(), 2U);
+  written.store(true);
+  reader_thread.join();
+  EXPECT_TRUE(was_empty);
+
+  s21_map.synchronize();
+  EXPECT_EQ(s21_map.retired(), 0U);
+  s21::rcu_map<int, int>::reader reader(s21_map);
+  EXPECT_TRUE(reader.contains(2));
+}
+
+TEST(rcu_map_threads, case1) {
+  s21::rcu_map<int, int> s21_map;
+  std::atomic<bool> done(false);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&s21_map, &done] {
+      s21::rcu_map<int, int>::reader reader(s21_map);
+      while (!done.load()) {
+        // Every version holds the keys 0..n-1 with values equal to n.
+        reader.read([](const s21::map<int, int> &version) {
+          int n = static_cast<int>(version.size());
+          for (const auto &elem : version) EXPECT_EQ(elem.second, n);
+        });
+      }
+    });
+  }
+  for (int n = 1; n <= 200; ++n) {
+    s21_map.update([n](s21::map<int, int> &next) {
+      next.insert(n - 1, 0);
+      for (auto &elem : next) elem.second = n;
+    });
+  }
+  done.store(true);
+  for (std::thread &reader : readers) reader.join();
+  s21_map.synchronize();
+  EXPECT_EQ(s21_map.retired(), 0U);
+
+  s21::rcu_map<int, int>::reader reader(s21_map);
+  EXPECT_EQ(*reader.find(199), 200);
+}
@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <set>
+#include <stdexcept>
+#include <string_view>
 
+#include "../s21_allocator.h"
 #include "../s21_set.h"
 
 TEST(set_constructor, case1) {
@@ -246,7 +252,7 @@ TEST(set_begin, case3) {
 TEST(set_begin, case4) {
   s21::set<int> s21_set;
 
-  EXPECT_THROW(s21_set.begin(), std::out_of_range);
+  EXPECT_EQ(s21_set.begin(), s21_set.end());
 }
 
 TEST(set_begin, case5) {
@@ -264,51 +270,51 @@ TEST(set_begin, case6) {
 TEST(set_end, case1) {
   s21::set<int> s21_set = {9, 15, 7, 23, 2};
 
-  EXPECT_EQ(*s21_set.end(), 23);
+  EXPECT_EQ(*std::prev(s21_set.end()), 23);
 }
 
 TEST(set_end, case2) {
   s21::set<double> s21_set = {11.4, 2.770001, 3.901, 11.400000001, 3.9};
 
-  EXPECT_EQ(*s21_set.end(), 11.400000001);
+  EXPECT_EQ(*std::prev(s21_set.end()), 11.400000001);
 }
 
 TEST(set_end, case3) {
   s21::set<std::string> s21_set = {"hello", "hi", "hola-hola", "hola",
                                    "hello, there"};
 
-  EXPECT_EQ(*s21_set.end(), "hola-hola");
+  EXPECT_EQ(*std::prev(s21_set.end()), "hola-hola");
 }
 
 TEST(set_end, case4) {
   s21::set<int> s21_set;
 
-  EXPECT_THROW(s21_set.end(), std::out_of_range);
+  EXPECT_EQ(s21_set.end(), s21_set.begin());
 }
 
 TEST(set_end, case5) {
   s21::set<double> s21_set = {1.4, 1.4};
 
-  EXPECT_EQ(*s21_set.end(), 1.4);
+  EXPECT_EQ(*std::prev(s21_set.end()), 1.4);
 }
 
 TEST(set_end, case6) {
   s21::set<std::string> s21_set = {"hello", "hello", "hello"};
 
-  EXPECT_EQ(*s21_set.end(), "hello");
+  EXPECT_EQ(*std::prev(s21_set.end()), "hello");
 }
 
 TEST(set_balance, case1) {
   s21::set<int> s21_set = {1, 15, 5};
 
-  EXPECT_EQ(*s21_set.end(), 15);
+  EXPECT_EQ(*std::prev(s21_set.end()), 15);
   EXPECT_EQ(s21_set.size(), 3U);
 }
 
 TEST(set_balance, case2) {
   s21::set<double> s21_set = {11.4, 2.770001, 3.901};
 
-  EXPECT_EQ(*s21_set.end(), 11.4);
+  EXPECT_EQ(*std::prev(s21_set.end()), 11.4);
   EXPECT_EQ(s21_set.size(), 3U);
 }
 
@@ -316,14 +322,14 @@ TEST(set_balance, case3) {
   s21::set<std::string> s21_set = {"hello", "hi", "hola-hola", "hola",
                                    "hello, there"};
 
-  EXPECT_EQ(*s21_set.end(), "hola-hola");
+  EXPECT_EQ(*std::prev(s21_set.end()), "hola-hola");
   EXPECT_EQ(s21_set.size(), 5U);
 }
 
 TEST(set_balance, case4) {
   s21::set<int> s21_set = {10, 5, 20, 30, 1543};
 
-  EXPECT_EQ(*s21_set.end(), 1543);
+  EXPECT_EQ(*std::prev(s21_set.end()), 1543);
   EXPECT_EQ(*s21_set.begin(), 5);
   EXPECT_EQ(s21_set.size(), 5U);
 }
@@ -331,7 +337,7 @@ TEST(set_balance, case4) {
 TEST(set_balance, case5) {
   s21::set<int> s21_set = {30, 5, 43, 1, 20, 40, 60, 35, 32};
 
-  EXPECT_EQ(*s21_set.end(), 60);
+  EXPECT_EQ(*std::prev(s21_set.end()), 60);
   EXPECT_EQ(*s21_set.begin(), 1);
   EXPECT_EQ(s21_set.size(), 9U);
 }
@@ -346,26 +352,26 @@ TEST(set_erase, case1) {
   it++;
   s21_set.erase(it);
   EXPECT_EQ(*s21_set.begin(), 4);
-  EXPECT_EQ(*s21_set.end(), 18);
+  EXPECT_EQ(*std::prev(s21_set.end()), 18);
   EXPECT_EQ(s21_set.size(), 6U);
 
   it = s21_set.begin();
   s21_set.erase(it);
   EXPECT_EQ(*s21_set.begin(), 5);
-  EXPECT_EQ(*s21_set.end(), 18);
+  EXPECT_EQ(*std::prev(s21_set.end()), 18);
   EXPECT_EQ(s21_set.size(), 5U);
 
   it = s21_set.begin();
   it++;
   s21_set.erase(it);
   EXPECT_EQ(*s21_set.begin(), 5);
-  EXPECT_EQ(*s21_set.end(), 18);
+  EXPECT_EQ(*std::prev(s21_set.end()), 18);
   EXPECT_EQ(s21_set.size(), 4U);
 
-  it = s21_set.end();
+  it = std::prev(s21_set.end());
   s21_set.erase(it);
   EXPECT_EQ(*s21_set.begin(), 5);
-  EXPECT_EQ(*s21_set.end(), 16);
+  EXPECT_EQ(*std::prev(s21_set.end()), 16);
   EXPECT_EQ(s21_set.size(), 3U);
 
   it = s21_set.begin();
@@ -398,31 +404,31 @@ TEST(set_erase, case3) {
   s21::set<std::string> s21_set = {"hello", "hi", "hola-hola", "hola",
                                    "hello, there"};
 
-  auto it = s21_set.end();
+  auto it = std::prev(s21_set.end());
   s21_set.erase(it);
-  EXPECT_EQ(*s21_set.end(), "hola");
+  EXPECT_EQ(*std::prev(s21_set.end()), "hola");
   EXPECT_EQ(s21_set.size(), 4U);
 
-  it = s21_set.end();
+  it = std::prev(s21_set.end());
   s21_set.erase(it);
-  EXPECT_EQ(*s21_set.end(), "hi");
+  EXPECT_EQ(*std::prev(s21_set.end()), "hi");
   EXPECT_EQ(s21_set.size(), 3U);
 
   s21_set.insert("hola-hola");
   s21_set.insert("hola");
-  it = s21_set.end();
+  it = std::prev(s21_set.end());
   s21_set.erase(it);
-  EXPECT_EQ(*s21_set.end(), "hola");
+  EXPECT_EQ(*std::prev(s21_set.end()), "hola");
   EXPECT_EQ(s21_set.size(), 4U);
 }
 
 TEST(set_erase, case4) {
   s21::set<double> s21_set = {22.2, 12.4457, 56.84, 941.44, 44.48};
 
-  auto it = s21_set.end();
+  auto it = std::prev(s21_set.end());
   it--;
   s21_set.erase(it);
-  it = s21_set.end();
+  it = std::prev(s21_set.end());
   EXPECT_EQ(*it, 941.44);
   EXPECT_EQ(s21_set.size(), 4U);
 
@@ -435,7 +441,7 @@ TEST(set_erase, case4) {
   ++it;
   ++it;
   ++it;
-  EXPECT_EQ(*s21_set.end(), 44.48);
+  EXPECT_EQ(*std::prev(s21_set.end()), 44.48);
   EXPECT_EQ(s21_set.size(), 3U);
 }
 
@@ -494,7 +500,7 @@ TEST(set_erase, case9) {
   s21::set<double> s21_set = {22.2,  44.48, 12.4457, 32.45,
                               65.12, 66.32, 40.54,   6.4};
 
-  auto it = s21_set.end();
+  auto it = std::prev(s21_set.end());
   it -= 4;
   s21_set.erase(it);
   it = s21_set.begin();
@@ -510,7 +516,6 @@ TEST(set_erase, case10) {
 
   auto it = s21_set.end();
   it -= 1;
-  ++it;
   s21_set.erase(it);
   EXPECT_EQ(s21_set.size(), 0U);
 }
@@ -531,7 +536,10 @@ TEST(set_MaxSize, case1) {
   s21::set<double> s21_set;
   std::set<double> std_set;
 
-  EXPECT_EQ(s21_set.max_size(), std_set.max_size());
+  // Order statistics cap a tree at what a 32-bit count holds.
+  EXPECT_EQ(s21_set.max_size(),
+            std::min<std::size_t>(std_set.max_size(),
+                                  std::numeric_limits<std::uint32_t>::max()));
 }
 
 TEST(set_MaxSize, case2) {
@@ -539,7 +547,10 @@ TEST(set_MaxSize, case2) {
 
   std::set<double> std_set = {22.2, 44.48, 12.4457, 1.44};
 
-  EXPECT_EQ(s21_set.max_size(), std_set.max_size());
+  // Order statistics cap a tree at what a 32-bit count holds.
+  EXPECT_EQ(s21_set.max_size(),
+            std::min<std::size_t>(std_set.max_size(),
+                                  std::numeric_limits<std::uint32_t>::max()));
 }
 
 TEST(set_swap, case1) {
@@ -638,7 +649,7 @@ TEST(set_contains, case4) {
 TEST(set_find, case1) {
   s21::set<double> s21_set;
 
-  EXPECT_THROW(s21_set.find(23.4), std::out_of_range);
+  EXPECT_EQ(s21_set.find(23.4), s21_set.end());
 }
 
 TEST(set_find, case2) {
@@ -655,67 +666,356 @@ TEST(set_find, case2) {
   EXPECT_EQ(*s21_set.find(22.2), *it);
 }
 
-TEST(set_emplace, case1) {
+TEST(set_insert_many, case1) {
   s21::set<int> s21_set;
 
-  std::vector<std::pair<s21::set<int>::iterator, bool>> emplace1 =
-      s21_set.emplace(9, 9, 9, 23, 98);
+  std::vector<std::pair<s21::set<int>::iterator, bool>> inserted =
+      s21_set.insert_many(9, 9, 9, 23, 98);
 
-  EXPECT_EQ(*emplace1[0].first, 23);
-  EXPECT_EQ(emplace1[0].second, true);
+  EXPECT_EQ(*inserted[0].first, 9);
+  EXPECT_EQ(inserted[0].second, true);
   EXPECT_EQ(s21_set.size(), 3U);
 }
 
-TEST(set_emplace, case2) {
+TEST(set_insert_many, case2) {
   s21::set<double> s21_set;
 
-  std::vector<std::pair<s21::set<double>::iterator, bool>> emplace1 =
-      s21_set.emplace(1.4, 2.77, 3.9, 2.77, 3.9);
+  std::vector<std::pair<s21::set<double>::iterator, bool>> inserted =
+      s21_set.insert_many(1.4, 2.77, 3.9, 2.77, 3.9);
 
-  EXPECT_EQ(*emplace1[0].first, 2.77);
-  EXPECT_EQ(emplace1[0].second, true);
+  EXPECT_EQ(*inserted[0].first, 1.4);
+  EXPECT_EQ(inserted[0].second, true);
   EXPECT_EQ(s21_set.size(), 3U);
 }
 
-TEST(set_emplace, case3) {
+TEST(set_insert_many, case3) {
   s21::set<std::string> s21_set;
 
-  std::vector<std::pair<s21::set<std::string>::iterator, bool>> emplace1 =
-      s21_set.emplace("hello", "hi", "hi", "hola", "hello");
+  std::vector<std::pair<s21::set<std::string>::iterator, bool>> inserted =
+      s21_set.insert_many("hello", "hi", "hi", "hola", "hello");
 
-  EXPECT_EQ(*emplace1[0].first, "hi");
-  EXPECT_EQ(emplace1[0].second, true);
+  EXPECT_EQ(*inserted[0].first, "hello");
+  EXPECT_EQ(inserted[0].second, true);
   EXPECT_EQ(s21_set.size(), 3U);
 }
 
-TEST(set_emplace, case4) {
+TEST(set_insert_many, case4) {
   s21::set<int> s21_set;
 
-  std::vector<std::pair<s21::set<int>::iterator, bool>> emplace1 =
-      s21_set.emplace(9);
+  std::vector<std::pair<s21::set<int>::iterator, bool>> inserted =
+      s21_set.insert_many(9);
 
-  EXPECT_EQ(*emplace1[0].first, 9);
-  EXPECT_EQ(emplace1[0].second, true);
+  EXPECT_EQ(*inserted[0].first, 9);
+  EXPECT_EQ(inserted[0].second, true);
   EXPECT_EQ(s21_set.size(), 1U);
 }
 
-TEST(set_emplace, case5) {
+TEST(set_insert_many, case5) {
   s21::set<double> s21_set = {1.4};
 
-  std::vector<std::pair<s21::set<double>::iterator, bool>> emplace1 =
-      s21_set.emplace(1.4);
+  std::vector<std::pair<s21::set<double>::iterator, bool>> inserted =
+      s21_set.insert_many(1.4);
 
-  EXPECT_EQ(emplace1[0].second, false);
+  EXPECT_EQ(inserted[0].second, false);
   EXPECT_EQ(s21_set.size(), 1U);
 }
 
-TEST(set_emplace, case6) {
+TEST(set_insert_many, case6) {
   s21::set<std::string> s21_set = {"hello"};
 
-  std::vector<std::pair<s21::set<std::string>::iterator, bool>> emplace1 =
-      s21_set.emplace("hi");
+  std::vector<std::pair<s21::set<std::string>::iterator, bool>> inserted =
+      s21_set.insert_many("hi");
 
-  EXPECT_EQ(*emplace1[0].first, "hi");
-  EXPECT_EQ(emplace1[0].second, true);
+  EXPECT_EQ(*inserted[0].first, "hi");
+  EXPECT_EQ(inserted[0].second, true);
   EXPECT_EQ(s21_set.size(), 2U);
 }
+
+TEST(set_find, case3) {
+  s21::set<int> s21_set = {5, 1, 9, 3, 7};
+
+  EXPECT_EQ(*s21_set.find(7), 7);
+  EXPECT_EQ(s21_set.find(4), s21_set.end());
+}
+
+TEST(set_bounds, case1) {
+  s21::set<int> s21_set = {10, 20, 30, 40, 50};
+
+  EXPECT_EQ(*s21_set.lower_bound(20), 20);
+  EXPECT_EQ(*s21_set.lower_bound(21), 30);
+  EXPECT_EQ(*s21_set.lower_bound(1), 10);
+  EXPECT_EQ(*s21_set.upper_bound(20), 30);
+  EXPECT_EQ(*s21_set.upper_bound(9), 10);
+  EXPECT_EQ(s21_set.lower_bound(51), s21_set.end());
+  EXPECT_EQ(s21_set.upper_bound(50), s21_set.end());
+}
+
+TEST(set_bounds, case2) {
+  s21::set<int> s21_set;
+  for (int i = 0; i < 1000; i += 2) s21_set.insert(i);
+
+  int visited = 0;
+  auto last = s21_set.lower_bound(200);
+  for (auto it = s21_set.lower_bound(101); it != last; ++it) {
+    EXPECT_GE(*it, 101);
+    EXPECT_LT(*it, 200);
+    ++visited;
+  }
+  EXPECT_EQ(visited, 49);
+}
+
+TEST(set_equal_range, case1) {
+  s21::set<std::string> s21_set = {"a", "c", "e"};
+
+  auto range = s21_set.equal_range("c");
+  EXPECT_EQ(*range.first, "c");
+  EXPECT_EQ(*range.second, "e");
+
+  range = s21_set.equal_range("b");
+  EXPECT_EQ(range.first, range.second);
+  EXPECT_EQ(*range.first, "c");
+}
+
+TEST(set_order_statistics, case1) {
+  s21::set<int> s21_set;
+  for (int i = 999; i >= 0; --i) s21_set.insert(i * 3);
+
+  EXPECT_EQ(*s21_set.nth(0), 0);
+  EXPECT_EQ(*s21_set.nth(500), 1500);
+  EXPECT_EQ(*s21_set.nth(999), 2997);
+  EXPECT_THROW(s21_set.nth(1000), std::out_of_range);
+
+  EXPECT_EQ(s21_set.rank(0), 0U);
+  EXPECT_EQ(s21_set.rank(1500), 500U);
+  EXPECT_EQ(s21_set.rank(1501), 501U);
+  EXPECT_EQ(s21_set.rank(5000), 1000U);
+}
+
+TEST(set_order_statistics, case2) {
+  s21::set<int> s21_set;
+  for (int i = 0; i < 300; ++i) s21_set.insert(i);
+  for (int i = 0; i < 300; i += 4) s21_set.erase(s21_set.find(i));
+
+  auto it = s21_set.begin();
+  it += 100;
+  EXPECT_EQ(*it, *s21_set.nth(100));
+  it -= 37;
+  EXPECT_EQ(*it, *s21_set.nth(63));
+  it += 1000;
+  EXPECT_EQ(it, s21_set.end());
+  it -= 1000;
+  EXPECT_EQ(*it, 1);
+  for (size_t k = 0; k < s21_set.size(); ++k)
+    EXPECT_EQ(s21_set.rank(*s21_set.nth(k)), k);
+}
+
+TEST(set_constructor, case8) {
+  std::vector<int> sorted;
+  for (int i = 0; i < 1000; ++i) sorted.push_back(i);
+  s21::set<int> s21_set(sorted.begin(), sorted.end());
+
+  EXPECT_EQ(s21_set.size(), 1000U);
+  EXPECT_EQ(*s21_set.begin(), 0);
+  EXPECT_EQ(*std::prev(s21_set.end()), 999);
+  EXPECT_EQ(*s21_set.nth(500), 500);
+  s21_set.insert(1000);
+  s21_set.erase(s21_set.find(0));
+  EXPECT_EQ(*s21_set.nth(999), 1000);
+}
+
+TEST(set_constructor, case9) {
+  std::vector<std::string> unsorted = {"pear", "apple", "fig", "apple", "kiwi",
+                                       "fig"};
+  s21::set<std::string> s21_set(unsorted.begin(), unsorted.end());
+  std::set<std::string> std_set(unsorted.begin(), unsorted.end());
+
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  size_t k = 0;
+  for (const auto &key : std_set) EXPECT_EQ(*s21_set.nth(k++), key);
+}
+
+TEST(set_assign, case1) {
+  s21::set<int> s21_set = {100, 200};
+  int keys[] = {5, 3, 3, 1, 4};
+  s21_set.assign(keys, keys + 5);
+
+  EXPECT_EQ(s21_set.size(), 4U);
+  EXPECT_EQ(*s21_set.begin(), 1);
+  EXPECT_FALSE(s21_set.contains(100));
+
+  s21::set<int> s21_set_copy;
+  s21_set_copy = s21_set;
+  EXPECT_EQ(s21_set_copy.size(), 4U);
+  EXPECT_EQ(*std::prev(s21_set_copy.end()), 5);
+}
+
+TEST(set_merge, case1) {
+  s21::set<int> s21_set;
+  s21::set<int> s21_set_other;
+  std::set<int> std_set;
+  for (int i = 0; i < 1000; i += 2) s21_set.insert(i), std_set.insert(i);
+  for (int i = 0; i < 1000; i += 3) s21_set_other.insert(i), std_set.insert(i);
+  s21_set.merge(s21_set_other);
+
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  EXPECT_TRUE(s21_set_other.empty());
+  size_t k = 0;
+  for (const auto &key : std_set) EXPECT_EQ(*s21_set.nth(k++), key);
+}
+
+TEST(set_algebra, case1) {
+  s21::set<int> lhs = {1, 2, 3, 4, 5, 6};
+  s21::set<int> rhs = {4, 5, 6, 7, 8};
+
+  s21::set<int> united = lhs;
+  united.unite(rhs);
+  EXPECT_EQ(united.size(), 8U);
+  EXPECT_EQ(*std::prev(united.end()), 8);
+
+  s21::set<int> common = lhs;
+  common.intersect(rhs);
+  EXPECT_EQ(common.size(), 3U);
+  EXPECT_EQ(*common.begin(), 4);
+
+  s21::set<int> difference = lhs;
+  difference.subtract(rhs);
+  EXPECT_EQ(difference.size(), 3U);
+  EXPECT_EQ(*std::prev(difference.end()), 3);
+  EXPECT_EQ(rhs.size(), 5U);
+
+  difference.subtract(difference);
+  EXPECT_TRUE(difference.empty());
+}
+
+TEST(set_split, case1) {
+  s21::set<int> s21_set = {1, 3, 5, 7, 9};
+  s21::set<int> s21_set_greater;
+
+  s21_set.split(6, s21_set_greater);
+  EXPECT_EQ(s21_set.size(), 3U);
+  EXPECT_EQ(*std::prev(s21_set.end()), 5);
+  EXPECT_EQ(*s21_set_greater.begin(), 7);
+
+  s21_set_greater.split(0, s21_set);
+  EXPECT_TRUE(s21_set_greater.empty());
+  EXPECT_EQ(s21_set.size(), 2U);
+}
+
+TEST(set_allocator, case1) {
+  using pool_set =
+      s21::set<double, std::less<>, s21::node_pool_allocator<double>>;
+  pool_set s21_set = {1.5, 2.5};
+  pool_set s21_set_other = {0.5};
+  EXPECT_EQ(s21_set.max_size(),
+            std::min<std::size_t>(std::set<double>().max_size(),
+                                  std::numeric_limits<std::uint32_t>::max()));
+
+  EXPECT_THROW(s21_set.join(s21_set_other), std::invalid_argument);
+  s21_set_other.join(s21_set);
+  EXPECT_EQ(s21_set_other.size(), 3U);
+  EXPECT_EQ(*std::prev(s21_set_other.end()), 2.5);
+
+  s21_set = s21_set_other;
+  s21_set.intersect(s21_set_other);
+  EXPECT_EQ(s21_set.size(), 3U);
+}
+
+TEST(set_heterogeneous, case1) {
+  s21::set<std::string> s21_set = {"apple", "banana", "cherry"};
+  EXPECT_TRUE(s21_set.contains(std::string_view("banana")));
+  EXPECT_FALSE(s21_set.contains("durian"));
+  EXPECT_EQ(*s21_set.find(std::string_view("cherry")), "cherry");
+  auto range = s21_set.equal_range(std::string_view("apple"));
+  EXPECT_EQ(*range.first, "apple");
+  EXPECT_EQ(*range.second, "banana");
+  EXPECT_EQ(s21_set.rank(std::string_view("c")), 2U);
+}
+
+// Throws on negative keys, so lookups have to let the exception through.
+struct NonNegativeLess {
+  bool operator()(int lhs, int rhs) const {
+    if (lhs < 0 || rhs < 0) throw std::domain_error("negative key");
+    return lhs < rhs;
+  }
+};
+
+TEST(set_heterogeneous, case2) {
+  s21::set<int, NonNegativeLess> s21_set = {1, 2, 3};
+  EXPECT_THROW(s21_set.contains(-1), std::domain_error);
+  EXPECT_THROW(s21_set.find(-1), std::domain_error);
+  EXPECT_THROW(s21_set.lower_bound(-1), std::domain_error);
+  EXPECT_THROW(s21_set.upper_bound(-1), std::domain_error);
+  EXPECT_THROW(s21_set.equal_range(-1), std::domain_error);
+  EXPECT_THROW(s21_set.rank(-1), std::domain_error);
+  EXPECT_THROW(s21_set.count(-1), std::domain_error);
+  EXPECT_EQ(*s21_set.find(2), 2);
+}
+
+TEST(set_order, case1) {
+  // Ascending inserts and scattered erasures exercise every rotation case
+  // while ranks must stay exact.
+  s21::set<int> s21_set;
+  for (int i = 0; i < 20000; ++i) s21_set.insert(i);
+  for (int i = 0; i < 20000; i += 3) s21_set.erase(s21_set.find(i));
+  s21::set<int> s21_set_copy(s21_set);
+  EXPECT_EQ(s21_set_copy.size(), s21_set.size());
+  size_t index = 0;
+  for (int i = 0; i < 20000; ++i) {
+    if (i % 3 == 0) continue;
+    EXPECT_EQ(*s21_set_copy.nth(index), i);
+    EXPECT_EQ(s21_set.rank(i), index);
+    ++index;
+  }
+  s21_set.clear();
+  EXPECT_TRUE(s21_set.empty());
+}
+
+TEST(set_iterator, case1) {
+  const s21::set<int> s21_set = {3, 1, 2};
+  std::vector<int> keys(s21_set.begin(), s21_set.end());
+  EXPECT_EQ(keys, std::vector<int>({1, 2, 3}));
+  EXPECT_EQ(*std::prev(s21_set.end(), 3), 1);
+  EXPECT_EQ(std::next(s21_set.begin(), 3), s21_set.end());
+}
+
+TEST(set_emplace, case1) {
+  s21::set<std::string> s21_set;
+  auto res = s21_set.emplace(3, 'a');
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(*res.first, "aaa");
+  EXPECT_FALSE(s21_set.emplace("aaa").second);
+  std::string word = "bbb";
+  EXPECT_TRUE(s21_set.insert(std::move(word)).second);
+  EXPECT_EQ(s21_set.size(), 2U);
+}
+
+TEST(set_extract, case1) {
+  s21::set<int> s21_set = {1, 2, 3};
+  s21::set<int> s21_set_other = {3};
+  auto node = s21_set.extract(s21_set.find(2));
+  EXPECT_EQ(node.value(), 2);
+  node.value() = 4;
+  auto res = s21_set_other.insert(std::move(node));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_EQ(*res.position, 4);
+
+  res = s21_set_other.insert(s21_set.extract(3));
+  EXPECT_FALSE(res.inserted);
+  EXPECT_EQ(res.node.value(), 3);
+  EXPECT_EQ(s21_set.size(), 1U);
+  EXPECT_EQ(s21_set_other.size(), 2U);
+}
+
+TEST(set_erase_range, case1) {
+  s21::set<int> s21_set;
+  for (int i = 0; i < 500; ++i) s21_set.insert(i * 2);
+  EXPECT_EQ(s21_set.erase_range(11, 101), 45U);
+  EXPECT_EQ(*s21_set.erase(s21_set.find(0), s21_set.find(6)), 6);
+  auto extracted = s21_set.extract_range(500, 600);
+  EXPECT_EQ(extracted.size(), 50U);
+  EXPECT_EQ(*extracted.begin(), 500);
+  EXPECT_EQ(s21_set.size(), 500U - 45U - 3U - 50U);
+  EXPECT_EQ(*s21_set.begin(), 6);
+  EXPECT_EQ(*s21_set.upper_bound(10), 102);
+  EXPECT_EQ(*s21_set.lower_bound(500), 600);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "../s21_unordered_map.h"
+
+TEST(unordered_map_constructor, case1) {
+  s21::unordered_map<int, std::string> s21_map = {
+      {3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+  std::unordered_map<int, std::string> std_map = {
+      {3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  for (const auto &elem : std_map)
+    EXPECT_EQ(s21_map.at(elem.first), elem.second);
+
+  s21::unordered_map<int, std::string> s21_map_copy(s21_map);
+  s21::unordered_map<int, std::string> s21_map_move(std::move(s21_map));
+  EXPECT_EQ(s21_map_copy.size(), 3U);
+  EXPECT_EQ(s21_map_move.at(2), "two");
+  EXPECT_TRUE(s21_map.empty());
+  EXPECT_TRUE(s21_map.begin() == s21_map.end());
+  EXPECT_TRUE(s21_map.find(1) == s21_map.end());
+
+  s21_map = s21_map_copy;
+  EXPECT_EQ(s21_map.size(), 3U);
+  EXPECT_EQ(s21_map[3], "three");
+}
+
+TEST(unordered_map_insert, case1) {
+  s21::unordered_map<std::uint64_t, int> s21_map;
+  std::unordered_map<std::uint64_t, int> std_map;
+  for (int i = 0; i < 20000; ++i) {
+    std::uint64_t key = static_cast<std::uint64_t>(i * 7919 % 15000) << 20;
+    EXPECT_EQ(s21_map.insert(key, i).second,
+              std_map.insert({key, i}).second);
+  }
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  EXPECT_LE(s21_map.load_factor(), s21_map.max_load_factor());
+
+  size_t visited = 0;
+  for (const auto &elem : s21_map) {
+    EXPECT_EQ(elem.second, std_map.at(elem.first));
+    ++visited;
+  }
+  EXPECT_EQ(visited, std_map.size());
+}
+
+TEST(unordered_map_erase, case1) {
+  s21::unordered_map<int, int> s21_map;
+  std::unordered_map<int, int> std_map;
+  // Churn leaves tombstones that later insertions have to reuse or purge.
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 500; ++i) {
+      int key = round * 300 + i;
+      s21_map[key] = i;
+      std_map[key] = i;
+    }
+    for (int i = 0; i < 450; ++i) {
+      int key = round * 300 + i * 2 % 500;
+      EXPECT_EQ(s21_map.erase(key), std_map.erase(key));
+    }
+  }
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  for (const auto &elem : std_map) {
+    auto it = s21_map.find(elem.first);
+    ASSERT_TRUE(it != s21_map.end());
+    EXPECT_EQ(it->second, elem.second);
+  }
+
+  for (auto it = s21_map.begin(); it != s21_map.end();) {
+    if (it->first % 3 == 0)
+      it = s21_map.erase(it);
+    else
+      ++it;
+  }
+  for (const auto &elem : std_map)
+    EXPECT_EQ(s21_map.contains(elem.first), elem.first % 3 != 0);
+}
+
+TEST(unordered_map_try_emplace, case1) {
+  s21::unordered_map<std::string, std::string> s21_map;
+  std::string key = "key";
+  std::string value = "value";
+  auto res = s21_map.try_emplace(std::move(key), 3, 'x');
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(res.first->second, "xxx");
+
+  std::string again = "key";
+  res = s21_map.try_emplace(std::move(again), value);
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(again, "key");
+  EXPECT_EQ(res.first->second, "xxx");
+
+  s21_map.insert_or_assign("key", "new");
+  EXPECT_EQ(s21_map.at("key"), "new");
+  EXPECT_THROW(s21_map.at("missing"), std::out_of_range);
+  EXPECT_EQ(s21_map.count("key"), 1U);
+  EXPECT_EQ(s21_map.count("missing"), 0U);
+}
+
+struct ModHash {
+  size_t operator()(int key) const { return static_cast<size_t>(key % 4); }
+};
+
+TEST(unordered_map_hash, case1) {
+  // Every key falls into one of four hash values, so probes run long.
+  s21::unordered_map<int, int, ModHash> s21_map;
+  s21_map.reserve(1000);
+  size_t buckets = s21_map.bucket_count();
+  for (int i = 0; i < 1000; ++i) s21_map.insert(i, -i);
+  EXPECT_EQ(s21_map.bucket_count(), buckets);
+  EXPECT_EQ(s21_map.size(), 1000U);
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(s21_map.at(i), -i);
+  EXPECT_FALSE(s21_map.contains(1000));
+
+  s21_map.clear();
+  EXPECT_TRUE(s21_map.empty());
+  EXPECT_EQ(s21_map.bucket_count(), buckets);
+  EXPECT_TRUE(s21_map.begin() == s21_map.end());
+}
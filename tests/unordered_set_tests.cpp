@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../s21_unordered_set.h"
+
+TEST(unordered_set_constructor, case1) {
+  std::vector<std::string> words = {"delta", "alpha", "charlie", "alpha"};
+  s21::unordered_set<std::string> s21_set(words.begin(), words.end());
+
+  EXPECT_EQ(s21_set.size(), 3U);
+  EXPECT_TRUE(s21_set.contains("alpha"));
+  EXPECT_FALSE(s21_set.contains("bravo"));
+
+  s21::unordered_set<std::string> s21_set_copy;
+  s21_set_copy = s21_set;
+  EXPECT_EQ(s21_set_copy.size(), 3U);
+  EXPECT_EQ(*s21_set_copy.find("charlie"), "charlie");
+}
+
+TEST(unordered_set_insert, case1) {
+  s21::unordered_set<int> s21_set;
+  std::unordered_set<int> std_set;
+  for (int i = 0; i < 5000; ++i) {
+    int key = (i * 31) % 3000;
+    EXPECT_EQ(s21_set.insert(key).second, std_set.insert(key).second);
+  }
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  std::unordered_set<int> seen(s21_set.begin(), s21_set.end());
+  EXPECT_TRUE(seen == std_set);
+}
+
+TEST(unordered_set_insert_many, case1) {
+  s21::unordered_set<int> s21_set = {1, 2};
+  auto res = s21_set.insert_many(3, 2, 4, 3);
+
+  ASSERT_EQ(res.size(), 4U);
+  EXPECT_TRUE(res[0].second);
+  EXPECT_FALSE(res[1].second);
+  EXPECT_TRUE(res[2].second);
+  EXPECT_FALSE(res[3].second);
+  EXPECT_EQ(*res[3].first, 3);
+  EXPECT_EQ(s21_set.size(), 4U);
+  EXPECT_EQ(s21_set.erase(2), 1U);
+  EXPECT_EQ(s21_set.count(2), 0U);
+}